@@ -34,6 +34,7 @@
 
 #include "SVF-LLVM/BasicTypes.h"
 #include "Util/Options.h"
+#include "Util/ExtAPI.h"
 #include "Graphs/BasicBlockG.h"
 
 namespace SVF
@@ -84,6 +85,8 @@ private:
     std::unique_ptr<LLVMContext> owned_ctx;
     std::vector<std::unique_ptr<Module>> owned_modules;
     std::vector<std::reference_wrapper<Module>> modules;
+    /// Hash of the bitcode files loaded from disk (0 if modules were passed in memory)
+    u64_t moduleHash;
 
     /// Record some "sse_" function declarations used in other ext function definition, e.g., svf_ext_foo(), and svf_ext_foo() used in app functions
     FunctionSetType ExtFuncsVec;
@@ -92,6 +95,8 @@ private:
 
     // Map SVFFunction to its annotations
     Map<const Function*, std::vector<std::string>> func2Annotations;
+    /// Compiled annotations of each function, set together with func2Annotations
+    Map<const Function*, ExtAPI::ExtFunDesc> func2ExtFunDesc;
 
     /// Global definition to a rep definition map
     GlobalDefToRepMapTy GlobalDefToRepMap;
@@ -160,6 +165,12 @@ public:
         return modules;
     }
 
+    /// Content hash of the loaded bitcode files; 0 if the modules were not read from files
+    inline u64_t getModuleHash() const
+    {
+        return moduleHash;
+    }
+
     Module *getModule(u32_t idx) const
     {
         return &getModuleRef(idx);
@@ -399,6 +410,10 @@ public:
 
     DominatorTree& getDomTree(const Function* fun);
 
+    /// Create the (not yet computed) dominator tree entries of funs up front, so
+    /// that getDomTree can then be called for distinct functions concurrently
+    void reserveDomTrees(const std::vector<const Function*>& funs);
+
     std::string getExtFuncAnnotation(const Function* fun, const std::string& funcAnnotation);
 
     const std::vector<std::string>& getExtFuncAnnotations(const Function* fun);
@@ -438,6 +453,9 @@ public:
     void setExtFuncAnnotations(const Function* fun, const std::vector<std::string>& funcAnnotations);
 
 private:
+    /// Whether the compiled annotations of (fun) carry flag
+    bool hasExtFunFlag(const Function* fun, u32_t flag) const;
+
     inline void addFunctionSet(const Function* svfFunc)
     {
         funSet.push_back(svfFunc);
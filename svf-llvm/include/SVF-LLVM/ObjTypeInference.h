@@ -53,6 +53,7 @@ public:
 private:
     ValueToInferSites _valueToInferSites; // value inference site cache
     ValueToType _valueToType; // value type cache
+    ValueToType _valueToObjType; // inferObjType result cache
     ValueToSources _valueToAllocs; // value allocations (stack, static, heap) cache
     ValueToClassNames _thisPtrClassNames; // thisptr class name cache
     ValueToSources _valueToAllocOrClsNameSources; // value alloc/clsname sources cache
@@ -69,6 +70,9 @@ public:
     /// get or infer the type of the object pointed by the value
     const Type *inferObjType(const Value *var);
 
+    /// inferObjType for a batch of values, forward inferring each of their allocations once
+    void inferObjTypes(const std::vector<const Value *> &vars);
+
     const Type *inferPointsToType(const Value *var);
 
     /// validate type inference
@@ -93,8 +97,21 @@ public:
 
     LLVMContext &getLLVMCtx();
 
+    /// Seed the object type and class name caches from a file written by writeCache
+    /// for the same input modules; returns false if the file is absent or was written for other modules
+    bool readCache(const std::string& fileName, u64_t moduleHash);
+
+    /// Dump the object type and class name caches of values nameable across runs
+    void writeCache(const std::string& fileName, u64_t moduleHash) const;
+
 private:
 
+    /// compute the type of the object pointed by the value (uncached)
+    const Type *computeObjType(const Value *var);
+
+    /// keys of globals, arguments and instructions that are stable across runs
+    class ValueKeys;
+
     /// forward infer the type of the object pointed by var
     const Type *fwInferObjType(const Value *var);
 
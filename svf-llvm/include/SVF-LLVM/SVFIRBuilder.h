@@ -48,14 +48,34 @@ class SVFIRBuilder: public llvm::InstVisitor<SVFIRBuilder>
 {
     friend class GraphDBSVFIRBuilder;
 
+public:
+    /// A statement of a function-local instruction, recorded while functions are
+    /// translated in parallel and added to the SVFIR later in function order.
+    /// Operands by kind: Copy/Load/Store (src, dst), Phi (src = incoming, dst = res, pred),
+    /// Select (src = op1, op2, cond, dst = res), Cmp/BinaryOp (src = op1, op2, dst),
+    /// UnaryOp (src, dst); opcode holds the copy kind, predicate or opcode.
+    struct PendingStmt
+    {
+        const Instruction* inst;
+        SVFStmt::PEDGEK kind;
+        NodeID src;
+        NodeID dst;
+        NodeID op2;
+        NodeID cond;
+        u32_t opcode;
+        const ICFGNode* pred;
+    };
+    typedef std::vector<PendingStmt> PendingStmtVec;
+
 private:
     SVFIR* pag;
     const SVFBasicBlock* curBB;	///< Current basic block during SVFIR construction when visiting the module
     const Value* curVal;	///< Current Value during SVFIR construction when visiting the module
+    PendingStmtVec* pendingStmts;	///< If set, statements are recorded here instead of being added to the SVFIR
 
 public:
     /// Constructor
-    SVFIRBuilder(): pag(SVFIR::getPAG()), curBB(nullptr),curVal(nullptr)
+    SVFIRBuilder(): pag(SVFIR::getPAG()), curBB(nullptr),curVal(nullptr),pendingStmts(nullptr)
     {
     }
     /// Destructor
@@ -84,6 +104,16 @@ public:
     void initSVFBasicBlock(const Function* func);
 
     void initDomTree(FunObjVar* func, const Function* f);
+    void initDomTrees(const std::vector<const Function*>& funs);
+
+    /// Translate functions into SVFStmts, function-local instructions in parallel
+    //@{
+    void buildFunStmts(const std::vector<const Function*>& funs);
+    void buildFunStmts(const Function& fun, const PendingStmtVec& stmts, bool recorded);
+    void recordFunStmts(const Function& fun, PendingStmtVec& stmts);
+    static bool isFunctionLocalStmt(const Instruction& inst);
+    void commitStmt(const PendingStmt& stmt);
+    //@}
 
     void addEdge(NodeID src, NodeID dst, SVFStmt::PEDGEK kind,
                  APOffset offset = 0, Instruction* cs = nullptr);
@@ -370,8 +400,20 @@ protected:
         return edge;
     }
 
+    /// Record a statement of the current instruction instead of adding it to the SVFIR
+    inline void recordStmt(SVFStmt::PEDGEK kind, NodeID src, NodeID dst, NodeID op2 = 0,
+                           NodeID cond = 0, u32_t opcode = 0, const ICFGNode* pred = nullptr)
+    {
+        pendingStmts->push_back({SVFUtil::cast<Instruction>(curVal), kind, src, dst, op2, cond, opcode, pred});
+    }
+
     inline CopyStmt* addCopyEdge(NodeID src, NodeID dst, CopyStmt::CopyKind kind)
     {
+        if (pendingStmts)
+        {
+            recordStmt(SVFStmt::Copy, src, dst, 0, 0, kind);
+            return nullptr;
+        }
         if(CopyStmt *edge = pag->addCopyStmt(src, dst, kind))
         {
             setCurrentBBAndValueForPAGEdge(edge);
@@ -420,6 +462,8 @@ protected:
     /// Add Copy edge
     inline void addPhiStmt(NodeID res, NodeID opnd, const ICFGNode* pred)
     {
+        if (pendingStmts)
+            return recordStmt(SVFStmt::Phi, opnd, res, 0, 0, 0, pred);
         /// If we already added this phi node, then skip this adding
         if(PhiStmt *edge = pag->addPhiStmt(res,opnd,pred))
             setCurrentBBAndValueForPAGEdge(edge);
@@ -427,24 +471,32 @@ protected:
     /// Add SelectStmt
     inline void addSelectStmt(NodeID res, NodeID op1, NodeID op2, NodeID cond)
     {
+        if (pendingStmts)
+            return recordStmt(SVFStmt::Select, op1, res, op2, cond);
         if(SelectStmt *edge = pag->addSelectStmt(res,op1,op2,cond))
             setCurrentBBAndValueForPAGEdge(edge);
     }
     /// Add Copy edge
     inline void addCmpEdge(NodeID op1, NodeID op2, NodeID dst, u32_t predict)
     {
+        if (pendingStmts)
+            return recordStmt(SVFStmt::Cmp, op1, dst, op2, 0, predict);
         if(CmpStmt *edge = pag->addCmpStmt(op1, op2, dst, predict))
             setCurrentBBAndValueForPAGEdge(edge);
     }
     /// Add Copy edge
     inline void addBinaryOPEdge(NodeID op1, NodeID op2, NodeID dst, u32_t opcode)
     {
+        if (pendingStmts)
+            return recordStmt(SVFStmt::BinaryOp, op1, dst, op2, 0, opcode);
         if(BinaryOPStmt *edge = pag->addBinaryOPStmt(op1, op2, dst, opcode))
             setCurrentBBAndValueForPAGEdge(edge);
     }
     /// Add Unary edge
     inline void addUnaryOPEdge(NodeID src, NodeID dst, u32_t opcode)
     {
+        if (pendingStmts)
+            return recordStmt(SVFStmt::UnaryOp, src, dst, 0, 0, opcode);
         if(UnaryOPStmt *edge = pag->addUnaryOPStmt(src, dst, opcode))
             setCurrentBBAndValueForPAGEdge(edge);
     }
@@ -457,12 +509,16 @@ protected:
     /// Add Load edge
     inline void addLoadEdge(NodeID src, NodeID dst)
     {
+        if (pendingStmts)
+            return recordStmt(SVFStmt::Load, src, dst);
         if(LoadStmt *edge = pag->addLoadStmt(src, dst))
             setCurrentBBAndValueForPAGEdge(edge);
     }
     /// Add Store edge
     inline void addStoreEdge(NodeID src, NodeID dst)
     {
+        if (pendingStmts)
+            return recordStmt(SVFStmt::Store, src, dst);
         ICFGNode* node;
         if (const Instruction* inst = SVFUtil::dyn_cast<Instruction>(curVal))
             node = llvmModuleSet()->getICFGNode(
@@ -99,6 +99,9 @@ protected:
     const Type *inferTypeOfHeapObjOrStaticObj(const Instruction* inst);
     //@}
 
+    /// Infer the types of all heap objects in one batch before their symbols are created
+    void inferHeapObjTypes();
+
 
     /// Create an objectInfo based on LLVM value
     ObjTypeInfo* createObjTypeInfo(const Value* val);
@@ -31,6 +31,10 @@
 
 #include <queue>
 #include <algorithm>
+#include <thread>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include "Util/SVFUtil.h"
 #include "SVF-LLVM/BasicTypes.h"
 #include "SVF-LLVM/LLVMUtil.h"
@@ -39,6 +43,8 @@
 #include "SVF-LLVM/SymbolTableBuilder.h"
 #include "MSSA/SVFGBuilder.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/xxhash.h"
 #include "SVF-LLVM/ObjTypeInference.h"
 #include "llvm/Transforms/Utils/Cloning.h"
 #include "SVF-LLVM/ICFGBuilder.h"
@@ -83,7 +89,7 @@ LLVMModuleSet* LLVMModuleSet::llvmModuleSet = nullptr;
 bool LLVMModuleSet::preProcessed = false;
 
 LLVMModuleSet::LLVMModuleSet()
-    : svfir(PAG::getPAG()), typeInference(new ObjTypeInference())
+    : svfir(PAG::getPAG()), moduleHash(0), typeInference(new ObjTypeInference())
 {
 }
 
@@ -103,12 +109,20 @@ ObjTypeInference* LLVMModuleSet::getTypeInference()
 DominatorTree& LLVMModuleSet::getDomTree(const SVF::Function* fun)
 {
     auto it = FunToDominatorTree.find(fun);
-    if(it != FunToDominatorTree.end()) return it->second;
-    DominatorTree& dt = FunToDominatorTree[fun];
-    dt.recalculate(const_cast<Function&>(*fun));
+    DominatorTree& dt = (it != FunToDominatorTree.end()) ? it->second : FunToDominatorTree[fun];
+    // entries created by reserveDomTrees have no root until first requested
+    if (dt.root_size() == 0)
+        dt.recalculate(const_cast<Function&>(*fun));
     return dt;
 }
 
+void LLVMModuleSet::reserveDomTrees(const std::vector<const Function*>& funs)
+{
+    FunToDominatorTree.reserve(FunToDominatorTree.size() + funs.size());
+    for (const Function* fun : funs)
+        FunToDominatorTree[fun];
+}
+
 void LLVMModuleSet::buildSVFModule(Module &mod)
 {
     LLVMModuleSet* mset = getLLVMModuleSet();
@@ -154,6 +168,8 @@ void LLVMModuleSet::buildSymbolTable() const
     {
         /// building symbol table
         DBOUT(DGENERAL, SVFUtil::outs() << SVFUtil::pasMsg("Building Symbol table ...\n"));
+        if (!Options::ObjTypeCache().empty() && moduleHash != 0)
+            typeInference->readCache(Options::ObjTypeCache(), moduleHash);
         SymbolTableBuilder builder(svfir);
         builder.buildMemModel();
     }
@@ -254,6 +270,8 @@ void LLVMModuleSet::createSVFDataStructure()
  */
 void LLVMModuleSet::prePassSchedule()
 {
+    double startPrePassTime = SVFStat::getClk(true);
+
     /// BreakConstantGEPs Pass
     std::unique_ptr<BreakConstantGEPs> p1 = std::make_unique<BreakConstantGEPs>();
     for (Module &M : getLLVMModules())
@@ -262,6 +280,7 @@ void LLVMModuleSet::prePassSchedule()
     }
 
     /// MergeFunctionRets Pass
+#if LLVM_VERSION_MAJOR <= 16
     std::unique_ptr<UnifyFunctionExitNodes> p2 =
         std::make_unique<UnifyFunctionExitNodes>();
     for (Module &M : getLLVMModules())
@@ -271,25 +290,37 @@ void LLVMModuleSet::prePassSchedule()
             Function &fun = *F;
             if (fun.isDeclaration())
                 continue;
-#if LLVM_VERSION_MAJOR <= 16
             p2->runOnFunction(fun);
-#else
-            llvm::PassBuilder PB;
-            llvm::LoopAnalysisManager LAM;
-            llvm::FunctionAnalysisManager FAM;
-            llvm::CGSCCAnalysisManager CGAM;
-            llvm::ModuleAnalysisManager MAM;
-            PB.registerModuleAnalyses(MAM);
-            PB.registerCGSCCAnalyses(CGAM);
-            PB.registerFunctionAnalyses(FAM);
-            PB.registerLoopAnalyses(LAM);
-            PB.crossRegisterProxies(LAM, FAM, CGAM, MAM);
-            llvm::FunctionPassManager FPM;
-            FPM.addPass(llvm::UnifyFunctionExitNodesPass());
-            FPM.run(fun, FAM);
-#endif
         }
     }
+#else
+    // The pass builder and analysis managers are set up once and shared by all
+    // modules; the module-to-function adaptor skips declarations.
+    llvm::PassBuilder PB;
+    llvm::LoopAnalysisManager LAM;
+    llvm::FunctionAnalysisManager FAM;
+    llvm::CGSCCAnalysisManager CGAM;
+    llvm::ModuleAnalysisManager MAM;
+    PB.registerModuleAnalyses(MAM);
+    PB.registerCGSCCAnalyses(CGAM);
+    PB.registerFunctionAnalyses(FAM);
+    PB.registerLoopAnalyses(LAM);
+    PB.crossRegisterProxies(LAM, FAM, CGAM, MAM);
+    for (Module &M : getLLVMModules())
+    {
+        llvm::FunctionPassManager FPM;
+        FPM.addPass(llvm::UnifyFunctionExitNodesPass());
+        llvm::ModulePassManager MPM;
+        MPM.addPass(llvm::createModuleToFunctionPassAdaptor(std::move(FPM)));
+        MPM.run(M, MAM);
+        // Analyses cached for this module are not needed for the next one
+        MAM.clear();
+        FAM.clear();
+    }
+#endif
+
+    double endPrePassTime = SVFStat::getClk(true);
+    SVFStat::timeOfLLVMPrePasses = (endPrePassTime - startPrePassTime) / TIMEINTERVAL;
 }
 
 void LLVMModuleSet::preProcessBCs(std::vector<std::string> &moduleNameVec)
@@ -357,7 +388,8 @@ void LLVMModuleSet::loadModules(const std::vector<std::string> &moduleNameVec)
     // This garbage collection should be avoided when building an SVF module from an LLVM
     // module instance; see the comment(s) in `buildSVFModule` and `loadExtAPIModules()`
 
-    owned_ctx = std::make_unique<LLVMContext>();
+    double startLoadTime = SVFStat::getClk(true);
+
     for (const std::string& moduleName : moduleNameVec)
     {
         if (!LLVMUtil::isIRFile(moduleName))
@@ -365,18 +397,104 @@ void LLVMModuleSet::loadModules(const std::vector<std::string> &moduleNameVec)
             SVFUtil::errs() << "not an IR file: " << moduleName << std::endl;
             abort();
         }
+    }
+
+    // Reading the files does not touch the LLVMContext, so it is spread over
+    // Options::ModuleLoadThreads() workers and overlaps with parsing. Parsing
+    // must use the single shared context and is done on this thread, in the
+    // given module order. Parsing into per-thread contexts is not an option, as
+    // modules can only be linked or cross-referenced within one context.
+    // Workers stay at most readAhead modules ahead of the parser, so that only
+    // a bounded number of file contents are held at once.
+    u32_t numThreads = std::min<u32_t>(std::max<u32_t>(Options::ModuleLoadThreads(), 1), moduleNameVec.size());
+    u32_t readAhead = 2 * numThreads;
+    std::vector<std::unique_ptr<llvm::MemoryBuffer>> buffers(moduleNameVec.size());
+    std::vector<std::string> readErrors(moduleNameVec.size());
+    std::vector<bool> isRead(moduleNameVec.size(), false);
+    u32_t numParsed = 0;
+    std::mutex readMutex;
+    std::condition_variable readCond;
+    std::atomic<u32_t> nextModule(0);
+    auto readModule = [&](u32_t i)
+    {
+        llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buf =
+            llvm::MemoryBuffer::getFileOrSTDIN(moduleNameVec[i]);
+        std::lock_guard<std::mutex> lock(readMutex);
+        if (buf)
+            buffers[i] = std::move(*buf);
+        else
+            readErrors[i] = buf.getError().message();
+        isRead[i] = true;
+    };
+    auto readWorker = [&]()
+    {
+        for (u32_t i = nextModule++; i < moduleNameVec.size(); i = nextModule++)
+        {
+            {
+                std::unique_lock<std::mutex> lock(readMutex);
+                readCond.wait(lock, [&]()
+                {
+                    return i < numParsed + readAhead;
+                });
+            }
+            readModule(i);
+            readCond.notify_all();
+        }
+    };
+    std::vector<std::thread> workers;
+    if (numThreads > 1)
+    {
+        for (u32_t i = 0; i < numThreads; ++i)
+            workers.push_back(std::thread(readWorker));
+    }
+
+    owned_ctx = std::make_unique<LLVMContext>();
+    for (u32_t i = 0; i < moduleNameVec.size(); ++i)
+    {
+        const std::string& moduleName = moduleNameVec[i];
+        std::unique_ptr<llvm::MemoryBuffer> buffer;
+        if (workers.empty())
+            readModule(i);
+        {
+            std::unique_lock<std::mutex> lock(readMutex);
+            readCond.wait(lock, [&]()
+            {
+                return isRead[i];
+            });
+            buffer = std::move(buffers[i]);
+        }
+        if (buffer == nullptr)
+        {
+            SVFUtil::errs() << "load module: " << moduleName << "failed!!\n\n";
+            SVFUtil::errs() << readErrors[i] << "\n";
+            abort();
+        }
+
+        moduleHash = moduleHash * 31 + llvm::xxHash64(buffer->getBuffer());
 
         SMDiagnostic Err;
-        std::unique_ptr<Module> mod = parseIRFile(moduleName, Err, *owned_ctx);
+        std::unique_ptr<Module> mod = parseIR(buffer->getMemBufferRef(), Err, *owned_ctx);
         if (mod == nullptr)
         {
             SVFUtil::errs() << "load module: " << moduleName << "failed!!\n\n";
             Err.print("SVFModuleLoader", llvm::errs());
             abort();
         }
+        // Release the file contents as soon as the module owns its IR, and let the workers read further
+        buffer.reset();
+        {
+            std::lock_guard<std::mutex> lock(readMutex);
+            numParsed = i + 1;
+        }
+        readCond.notify_all();
         modules.emplace_back(*mod);
         owned_modules.emplace_back(std::move(mod));
     }
+    for (std::thread &worker : workers)
+        worker.join();
+
+    double endLoadTime = SVFStat::getClk(true);
+    SVFStat::timeOfLoadingLLVMModules = (endLoadTime - startLoadTime) / TIMEINTERVAL;
 }
 
 void LLVMModuleSet::loadExtAPIModules()
@@ -404,7 +522,15 @@ void LLVMModuleSet::loadExtAPIModules()
             abort();
         }
         SMDiagnostic Err;
-        std::unique_ptr<Module> mod = parseIRFile(extModuleName, Err, getContext());
+        std::unique_ptr<Module> mod;
+        llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buf = llvm::MemoryBuffer::getFile(extModuleName);
+        if (buf)
+        {
+            // Only modules read from disk are hashed (see getModuleHash)
+            if (moduleHash != 0)
+                moduleHash = moduleHash * 31 + llvm::xxHash64((*buf)->getBuffer());
+            mod = parseIR((*buf)->getMemBufferRef(), Err, getContext());
+        }
         if (mod == nullptr)
         {
             SVFUtil::errs() << "load external module: " << extModuleName << "failed!!\n\n";
@@ -1508,6 +1634,15 @@ void LLVMModuleSet::setExtFuncAnnotations(const Function* fun, const std::vector
 {
     assert(fun && "Null SVFFunction* pointer");
     func2Annotations[fun] = funcAnnotations;
+    func2ExtFunDesc[fun] = ExtAPI::compileAnnotations(funcAnnotations);
+}
+
+bool LLVMModuleSet::hasExtFunFlag(const Function* fun, u32_t flag) const
+{
+    if (fun == nullptr)
+        return false;
+    auto it = func2ExtFunDesc.find(fun);
+    return it != func2ExtFunDesc.end() && (it->second.flags & flag);
 }
 
 bool LLVMModuleSet::hasExtFuncAnnotation(const Function* fun, const std::string& funcAnnotation)
@@ -1547,52 +1682,44 @@ const std::vector<std::string>& LLVMModuleSet::getExtFuncAnnotations(const Funct
 
 bool LLVMModuleSet::is_memcpy(const Function *F)
 {
-    return F &&
-           (hasExtFuncAnnotation(F, "MEMCPY") ||  hasExtFuncAnnotation(F, "STRCPY")
-            || hasExtFuncAnnotation(F, "STRCAT"));
+    return hasExtFunFlag(F, ExtAPI::EF_MEMCPY);
 }
 
 bool LLVMModuleSet::is_memset(const Function *F)
 {
-    return F && hasExtFuncAnnotation(F, "MEMSET");
+    return hasExtFunFlag(F, ExtAPI::EF_MEMSET);
 }
 
 bool LLVMModuleSet::is_alloc(const Function* F)
 {
-    return F && hasExtFuncAnnotation(F, "ALLOC_HEAP_RET");
+    return hasExtFunFlag(F, ExtAPI::EF_ALLOC_HEAP_RET);
 }
 
 // Does (F) allocate a new object and assign it to one of its arguments?
 bool LLVMModuleSet::is_arg_alloc(const Function* F)
 {
-    return F && hasExtFuncAnnotation(F, "ALLOC_HEAP_ARG");
+    return hasExtFunFlag(F, ExtAPI::EF_ALLOC_HEAP_ARG);
 }
 
 bool LLVMModuleSet::is_alloc_stack_ret(const Function* F)
 {
-    return F && hasExtFuncAnnotation(F, "ALLOC_STACK_RET");
+    return hasExtFunFlag(F, ExtAPI::EF_ALLOC_STACK_RET);
 }
 
 // Get the position of argument which holds the new object
 s32_t LLVMModuleSet::get_alloc_arg_pos(const Function* F)
 {
-    std::string allocArg = getExtFuncAnnotation(F, "ALLOC_HEAP_ARG");
-    assert(!allocArg.empty() && "Not an alloc call via argument or incorrect extern function annotation!");
-
-    std::string number;
-    for (char c : allocArg)
-    {
-        if (isdigit(c))
-            number.push_back(c);
-    }
-    assert(!number.empty() && "Incorrect naming convention for svf external functions(ALLOC_HEAP_ARG + number)?");
-    return std::stoi(number);
+    auto it = func2ExtFunDesc.find(F);
+    assert(it != func2ExtFunDesc.end() && (it->second.flags & ExtAPI::EF_ALLOC_HEAP_ARG) &&
+           "Not an alloc call via argument or incorrect extern function annotation!");
+    assert(it->second.allocArgPos >= 0 && "Incorrect naming convention for svf external functions(ALLOC_HEAP_ARG + number)?");
+    return it->second.allocArgPos;
 }
 
 // Does (F) reallocate a new object?
 bool LLVMModuleSet::is_realloc(const Function* F)
 {
-    return F && hasExtFuncAnnotation(F, "REALLOC_HEAP_RET");
+    return hasExtFunFlag(F, ExtAPI::EF_REALLOC_HEAP_RET);
 }
 
 
@@ -1603,8 +1730,9 @@ bool LLVMModuleSet::is_ext(const Function* F)
     assert(F && "Null SVFFunction* pointer");
     if (F->isDeclaration() || F->isIntrinsic())
         return true;
-    else if (hasExtFuncAnnotation(F, "OVERWRITE") && getExtFuncAnnotations(F).size() == 1)
+    auto it = func2ExtFunDesc.find(F);
+    if (it == func2ExtFunDesc.end() || (it->second.flags & ExtAPI::EF_OVERWRITE_ONLY))
         return false;
     else
-        return !getExtFuncAnnotations(F).empty();
+        return it->second.numAnnotations != 0;
 }
@@ -33,6 +33,8 @@
 #include "SVF-LLVM/LLVMUtil.h"
 #include "SVF-LLVM/CppUtil.h"
 #include "Util/Casting.h"
+#include <fstream>
+#include <sstream>
 
 #define TYPE_DEBUG 0 /* Turn this on if you're debugging type inference */
 #define ERR_MSG(msg)                                                           \
@@ -134,6 +136,47 @@ LLVMContext &ObjTypeInference::getLLVMCtx()
  * @param val
  */
 const Type *ObjTypeInference::inferObjType(const Value *var)
+{
+    auto tIt = _valueToObjType.find(var);
+    if (tIt != _valueToObjType.end()) return tIt->second;
+    const Type* res = computeObjType(var);
+    _valueToObjType[var] = res;
+    return res;
+}
+
+/*!
+ * Batched inferObjType: the allocations of all values are collected first
+ * and each distinct allocation is forward inferred once from a single
+ * worklist, before the per-value results are combined. The forward walks
+ * fill _valueToInferSites for every value they resolve, so the walks of later
+ * allocations stop at the values shared with earlier ones.
+ * @param vars
+ */
+void ObjTypeInference::inferObjTypes(const std::vector<const Value *> &vars)
+{
+    FIFOWorkList<const Value *> allocs;
+    Set<const Value *> queued;
+    for (const Value *var: vars)
+    {
+        if (_valueToObjType.count(var)) continue;
+        if (isAlloc(var))
+        {
+            if (queued.insert(var).second) allocs.push(var);
+            continue;
+        }
+        for (const Value *alloc: bwfindAllocOfVar(var))
+        {
+            if (queued.insert(alloc).second) allocs.push(alloc);
+        }
+    }
+    while (!allocs.empty())
+        fwInferObjType(allocs.pop());
+
+    for (const Value *var: vars)
+        inferObjType(var);
+}
+
+const Type *ObjTypeInference::computeObjType(const Value *var)
 {
     const Type* res = inferPointsToType(var);
     // infer type by leveraging the type alignment of src and dst in memcpy
@@ -1002,3 +1045,362 @@ Set<const CallBase *> &ObjTypeInference::fwFindClsNameSources(const Value *start
     // Store sources in cache for starting value & return the found sources
     return _objToClsNameSources[startValue] = SVFUtil::move(sources);
 }
+
+namespace
+{
+/*
+ * Cross-run cache of inferred object types. The file is line based:
+ *
+ *   SVF-OBJTYPE-CACHE <moduleHash>
+ *   T <tab> <valueKey> <tab> <encodedType>
+ *   C <tab> <valueKey> <tab> <className> <tab> <className> ...
+ *
+ * Types are encoded prefix-wise so that they can be rebuilt in a fresh
+ * LLVMContext without re-parsing IR:
+ *   i<bits>                 integer
+ *   p<addrspace>            pointer
+ *   s<len>:<name>           identified struct (looked up by name)
+ *   l<packed><n>.<elems>    literal struct
+ *   a<n>.<elem>             array
+ *   v<n>.<elem>             fixed vector
+ *   f<vararg><n>.<ret><params> function
+ *   t<name>.                other primitive types, named as in LLVM IR
+ *                           (void, half, float, double, fp128, label, ...)
+ */
+const char* const ObjTypeCacheMagic = "SVF-OBJTYPE-CACHE";
+
+/// Primitive types by their LLVM IR name, which unlike Type::TypeID does not
+/// change between LLVM versions
+const std::pair<const char*, Type* (*)(LLVMContext&)> PrimitiveTypes[] =
+{
+    {"void", Type::getVoidTy},
+    {"half", Type::getHalfTy},
+    {"bfloat", Type::getBFloatTy},
+    {"float", Type::getFloatTy},
+    {"double", Type::getDoubleTy},
+    {"x86_fp80", Type::getX86_FP80Ty},
+    {"fp128", Type::getFP128Ty},
+    {"ppc_fp128", Type::getPPC_FP128Ty},
+    {"label", Type::getLabelTy},
+    {"metadata", Type::getMetadataTy},
+};
+
+const char* primitiveTypeName(const Type* ty)
+{
+    for (const auto& prim : PrimitiveTypes)
+    {
+        if (prim.second(ty->getContext()) == ty)
+            return prim.first;
+    }
+    return nullptr;
+}
+
+bool encodeType(const Type* ty, std::string& out)
+{
+    if (const IntegerType* intTy = SVFUtil::dyn_cast<IntegerType>(ty))
+    {
+        out += "i" + std::to_string(intTy->getBitWidth());
+    }
+    else if (const PointerType* ptrTy = SVFUtil::dyn_cast<PointerType>(ty))
+    {
+        out += "p" + std::to_string(ptrTy->getAddressSpace());
+    }
+    else if (const StructType* stTy = SVFUtil::dyn_cast<StructType>(ty))
+    {
+        if (!stTy->isLiteral())
+        {
+            if (!stTy->hasName()) return false;
+            std::string name = stTy->getName().str();
+            out += "s" + std::to_string(name.size()) + ":" + name;
+            return true;
+        }
+        out += "l" + std::to_string(stTy->isPacked()) + std::to_string(stTy->getNumElements()) + ".";
+        for (const Type* elemTy : stTy->elements())
+            if (!encodeType(elemTy, out)) return false;
+    }
+    else if (const ArrayType* arrTy = SVFUtil::dyn_cast<ArrayType>(ty))
+    {
+        out += "a" + std::to_string(arrTy->getNumElements()) + ".";
+        return encodeType(arrTy->getElementType(), out);
+    }
+    else if (const llvm::FixedVectorType* vecTy = SVFUtil::dyn_cast<llvm::FixedVectorType>(ty))
+    {
+        out += "v" + std::to_string(vecTy->getNumElements()) + ".";
+        return encodeType(vecTy->getElementType(), out);
+    }
+    else if (const FunctionType* funTy = SVFUtil::dyn_cast<FunctionType>(ty))
+    {
+        out += "f" + std::to_string(funTy->isVarArg()) + std::to_string(funTy->getNumParams()) + ".";
+        if (!encodeType(funTy->getReturnType(), out)) return false;
+        for (const Type* paramTy : funTy->params())
+            if (!encodeType(paramTy, out)) return false;
+    }
+    else if (const char* name = primitiveTypeName(ty))
+    {
+        out += "t" + std::string(name) + ".";
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+bool decodeNumber(const std::string& in, size_t& pos, u64_t& num)
+{
+    size_t start = pos;
+    num = 0;
+    while (pos < in.size() && std::isdigit(static_cast<unsigned char>(in[pos])))
+        num = num * 10 + (in[pos++] - '0');
+    return pos != start;
+}
+
+/// decode a count followed by the '.' separator (used by aggregates);
+/// the leading flag digit (packed/vararg) is split off by the caller
+bool decodeCount(const std::string& in, size_t& pos, u64_t& num)
+{
+    if (!decodeNumber(in, pos, num) || pos >= in.size() || in[pos] != '.') return false;
+    ++pos;
+    return true;
+}
+
+Type* decodeType(LLVMContext& ctx, const std::string& in, size_t& pos)
+{
+    if (pos >= in.size()) return nullptr;
+    char kind = in[pos++];
+    u64_t num = 0;
+    switch (kind)
+    {
+    case 'i':
+        return decodeNumber(in, pos, num) ? IntegerType::get(ctx, num) : nullptr;
+    case 'p':
+        return decodeNumber(in, pos, num) ? PointerType::get(ctx, num) : nullptr;
+    case 's':
+    {
+        if (!decodeNumber(in, pos, num) || pos >= in.size() || in[pos] != ':' || pos + 1 + num > in.size())
+            return nullptr;
+        std::string name = in.substr(pos + 1, num);
+        pos += 1 + num;
+        return StructType::getTypeByName(ctx, name);
+    }
+    case 'l':
+    case 'f':
+    {
+        if (pos >= in.size()) return nullptr;
+        bool flag = in[pos++] == '1';
+        if (!decodeCount(in, pos, num)) return nullptr;
+        Type* retTy = nullptr;
+        if (kind == 'f' && !(retTy = decodeType(ctx, in, pos))) return nullptr;
+        std::vector<Type*> elems;
+        for (u64_t i = 0; i < num; ++i)
+        {
+            Type* elemTy = decodeType(ctx, in, pos);
+            if (!elemTy) return nullptr;
+            elems.push_back(elemTy);
+        }
+        if (kind == 'f') return FunctionType::get(retTy, elems, flag);
+        return StructType::get(ctx, elems, flag);
+    }
+    case 'a':
+    case 'v':
+    {
+        if (!decodeCount(in, pos, num)) return nullptr;
+        Type* elemTy = decodeType(ctx, in, pos);
+        if (!elemTy) return nullptr;
+        if (kind == 'a') return ArrayType::get(elemTy, num);
+        return llvm::FixedVectorType::get(elemTy, num);
+    }
+    case 't':
+    {
+        size_t end = in.find('.', pos);
+        if (end == std::string::npos) return nullptr;
+        std::string name = in.substr(pos, end - pos);
+        pos = end + 1;
+        for (const auto& prim : PrimitiveTypes)
+        {
+            if (name == prim.first)
+                return prim.second(ctx);
+        }
+        return nullptr;
+    }
+    default:
+        return nullptr;
+    }
+}
+} // End anonymous namespace
+
+/*!
+ * Keys of values that are stable across runs: every named global, every
+ * argument and every instruction of a named function is keyed by its module
+ * index and position, e.g. "0:G:foo", "0:A:foo:1", "0:I:foo:42". Values that
+ * cannot be named this way (constant expressions, unnamed functions) are left
+ * out of the cache. Instructions of a function are only numbered once one of
+ * them is looked up, so a small cache does not index the whole program.
+ */
+class ObjTypeInference::ValueKeys
+{
+public:
+    ValueKeys()
+    {
+        LLVMModuleSet* mset = LLVMModuleSet::getLLVMModuleSet();
+        for (u32_t m = 0; m < mset->getModuleNum(); ++m)
+        {
+            modules.push_back(mset->getModule(m));
+            moduleToIdx[modules.back()] = m;
+        }
+    }
+
+    /// Return false if val has no stable key
+    bool getKey(const Value* val, std::string& key)
+    {
+        const Function* fun = nullptr;
+        std::string kind;
+        std::string pos;
+        if (const GlobalValue* global = SVFUtil::dyn_cast<GlobalValue>(val))
+        {
+            if (!global->hasName() || !moduleToIdx.count(global->getParent())) return false;
+            key = std::to_string(moduleToIdx[global->getParent()]) + ":G:" + global->getName().str();
+            return true;
+        }
+        else if (const Argument* arg = SVFUtil::dyn_cast<Argument>(val))
+        {
+            fun = arg->getParent();
+            kind = ":A:";
+            pos = std::to_string(arg->getArgNo());
+        }
+        else if (const Instruction* inst = SVFUtil::dyn_cast<Instruction>(val))
+        {
+            fun = inst->getFunction();
+            kind = ":I:";
+            indexInsts(fun);
+            pos = std::to_string(instToIdx[inst]);
+        }
+        if (fun == nullptr || !fun->hasName() || !moduleToIdx.count(fun->getParent()))
+            return false;
+        key = std::to_string(moduleToIdx[fun->getParent()]) + kind + fun->getName().str() + ":" + pos;
+        return true;
+    }
+
+    /// Return nullptr if key names no value of the loaded modules
+    const Value* getValue(const std::string& key)
+    {
+        size_t sep = key.find(':');
+        if (sep == std::string::npos || sep + 3 > key.size() || key[sep + 2] != ':')
+            return nullptr;
+        u64_t m = 0;
+        for (size_t i = 0; i < sep; ++i)
+        {
+            if (!std::isdigit(static_cast<unsigned char>(key[i]))) return nullptr;
+            m = m * 10 + (key[i] - '0');
+        }
+        if (sep == 0 || m >= modules.size()) return nullptr;
+        const Module* mod = modules[m];
+        char kind = key[sep + 1];
+        std::string rest = key.substr(sep + 3);
+        if (kind == 'G')
+            return mod->getNamedValue(rest);
+
+        size_t last = rest.rfind(':');
+        if (last == std::string::npos || last + 1 == rest.size()) return nullptr;
+        const Function* fun = mod->getFunction(rest.substr(0, last));
+        if (fun == nullptr) return nullptr;
+        u64_t idx = 0;
+        for (size_t i = last + 1; i < rest.size(); ++i)
+        {
+            if (!std::isdigit(static_cast<unsigned char>(rest[i]))) return nullptr;
+            idx = idx * 10 + (rest[i] - '0');
+        }
+        if (kind == 'A')
+            return idx < fun->arg_size() ? fun->getArg(idx) : nullptr;
+        if (kind != 'I')
+            return nullptr;
+        const std::vector<const Instruction*>& insts = indexInsts(fun);
+        return idx < insts.size() ? insts[idx] : nullptr;
+    }
+
+private:
+    const std::vector<const Instruction*>& indexInsts(const Function* fun)
+    {
+        auto it = funToInsts.find(fun);
+        if (it != funToInsts.end())
+            return it->second;
+        std::vector<const Instruction*>& insts = funToInsts[fun];
+        for (const Instruction& inst : instructions(fun))
+        {
+            instToIdx[&inst] = insts.size();
+            insts.push_back(&inst);
+        }
+        return insts;
+    }
+
+    std::vector<const Module*> modules;
+    Map<const Module*, u32_t> moduleToIdx;
+    Map<const Function*, std::vector<const Instruction*>> funToInsts;
+    Map<const Instruction*, u32_t> instToIdx;
+};
+
+bool ObjTypeInference::readCache(const std::string& fileName, u64_t moduleHash)
+{
+    std::ifstream in(fileName);
+    if (!in.is_open()) return false;
+
+    std::string line;
+    if (!std::getline(in, line) || line != std::string(ObjTypeCacheMagic) + " " + std::to_string(moduleHash))
+        return false;
+
+    ValueKeys keys;
+    LLVMContext& ctx = getLLVMCtx();
+    while (std::getline(in, line))
+    {
+        std::vector<std::string> fields;
+        std::istringstream ss(line);
+        std::string field;
+        while (std::getline(ss, field, '\t'))
+            fields.push_back(field);
+        if (fields.size() < 2) continue;
+
+        const Value* val = keys.getValue(fields[1]);
+        if (val == nullptr) continue;
+
+        if (fields[0] == "T" && fields.size() == 3)
+        {
+            size_t pos = 0;
+            if (const Type* ty = decodeType(ctx, fields[2], pos))
+                _valueToObjType[val] = ty;
+        }
+        else if (fields[0] == "C")
+        {
+            Set<std::string>& names = _thisPtrClassNames[val];
+            names.insert(fields.begin() + 2, fields.end());
+        }
+    }
+    return true;
+}
+
+void ObjTypeInference::writeCache(const std::string& fileName, u64_t moduleHash) const
+{
+    std::ofstream out(fileName);
+    if (!out.is_open())
+    {
+        SVFUtil::errs() << "Unable to write object type cache " << fileName << "\n";
+        return;
+    }
+
+    ValueKeys keys;
+    out << ObjTypeCacheMagic << " " << moduleHash << "\n";
+    std::string key;
+    for (const auto& item : _valueToObjType)
+    {
+        std::string encoded;
+        if (!keys.getKey(item.first, key) || !encodeType(item.second, encoded)) continue;
+        out << "T\t" << key << "\t" << encoded << "\n";
+    }
+    for (const auto& item : _thisPtrClassNames)
+    {
+        if (!keys.getKey(item.first, key)) continue;
+        out << "C\t" << key;
+        for (const std::string& name : item.second)
+            out << "\t" << name;
+        out << "\n";
+    }
+}
@@ -42,6 +42,8 @@
 #include "Graphs/CallGraph.h"
 #include "Util/Options.h"
 #include "Util/SVFUtil.h"
+#include <atomic>
+#include <thread>
 
 using namespace std;
 using namespace SVF;
@@ -94,58 +96,13 @@ SVFIR* SVFIRBuilder::build()
     pag->setCHG(chg);
 
     /// handle functions
+    std::vector<const Function*> funs;
     for (Module& M : llvmModuleSet()->getLLVMModules())
     {
         for (Module::const_iterator F = M.begin(), E = M.end(); F != E; ++F)
-        {
-            const Function& fun = *F;
-            const FunObjVar* svffun = llvmModuleSet()->getFunObjVar(&fun);
-            /// collect return node of function fun
-            if(!fun.isDeclaration())
-            {
-                /// Return SVFIR node will not be created for function which can not
-                /// reach the return instruction due to call to abort(), exit(),
-                /// etc. In 176.gcc of SPEC 2000, function build_objc_string() from
-                /// c-lang.c shows an example when fun.doesNotReturn() evaluates
-                /// to TRUE because of abort().
-                if (fun.doesNotReturn() == false &&
-                        fun.getReturnType()->isVoidTy() == false)
-                {
-                    pag->addFunRet(svffun,
-                                   pag->getValVar(pag->getReturnNode(svffun)));
-                }
-
-                /// To be noted, we do not record arguments which are in declared function without body
-                /// TODO: what about external functions with SVFIR imported by commandline?
-                for (Function::const_arg_iterator I = fun.arg_begin(), E = fun.arg_end();
-                        I != E; ++I)
-                {
-                    setCurrentLocation(&*I,&fun.getEntryBlock());
-                    NodeID argValNodeId = llvmModuleSet()->getValueNode(&*I);
-                    // if this is the function does not have caller (e.g. main)
-                    // or a dead function, shall we create a black hole address edge for it?
-                    // it is (1) too conservative, and (2) make FormalParmVFGNode defined at blackhole address PAGEdge.
-                    // if(SVFUtil::ArgInNoCallerFunction(&*I)) {
-                    //    if(I->getType()->isPointerTy())
-                    //        addBlackHoleAddrEdge(argValNodeId);
-                    //}
-                    pag->addFunArgs(svffun,pag->getValVar(argValNodeId));
-                }
-            }
-            for (Function::const_iterator bit = fun.begin(), ebit = fun.end();
-                    bit != ebit; ++bit)
-            {
-                const BasicBlock& bb = *bit;
-                for (BasicBlock::const_iterator it = bb.begin(), eit = bb.end();
-                        it != eit; ++it)
-                {
-                    const Instruction& inst = *it;
-                    setCurrentLocation(&inst,&bb);
-                    visit(const_cast<Instruction&>(inst));
-                }
-            }
-        }
+            funs.push_back(&*F);
     }
+    buildFunStmts(funs);
 
     sanityCheck();
 
@@ -177,6 +134,11 @@ SVFIR* SVFIRBuilder::build()
         assert(false && "please implement SVFIRWriter::writeJsonToPath");
     }
 
+    // persist the object types inferred while building the symbol table and SVFIR
+    LLVMModuleSet* mset = llvmModuleSet();
+    if (!Options::ObjTypeCache().empty() && mset->getModuleHash() != 0)
+        mset->getTypeInference()->writeCache(Options::ObjTypeCache(), mset->getModuleHash());
+
     double endTime = SVFStat::getClk(true);
     SVFStat::timeOfBuildingSVFIR = (endTime - startTime) / TIMEINTERVAL;
 
@@ -185,6 +147,7 @@ SVFIR* SVFIRBuilder::build()
 
 void SVFIRBuilder::initFunObjVar()
 {
+    std::vector<const Function*> defFuns;
     for (Module& mod : llvmModuleSet()->getLLVMModules())
     {
         /// Function
@@ -195,13 +158,14 @@ void SVFIRBuilder::initFunObjVar()
 
             if (!LLVMUtil::isExtCall(&f))
             {
-                initDomTree(svffun, &f);
+                defFuns.push_back(&f);
             }
             /// set realDefFun for all functions
             const Function *realfun = llvmModuleSet()->getRealDefFun(&f);
             svffun->setRelDefFun(realfun == nullptr ? nullptr : llvmModuleSet()->getFunObjVar(realfun));
         }
     }
+    initDomTrees(defFuns);
 
     // Store annotations of functions in extapi.bc
     for (const auto& pair : llvmModuleSet()->ExtFun2Annotations)
@@ -254,6 +218,227 @@ void SVFIRBuilder::initSVFBasicBlock(const Function* func)
 }
 
 
+/*!
+ * Translate the instructions of all functions into SVFStmts.
+ * Functions are handled in batches. Within a batch, the statements of
+ * function-local instructions (see isFunctionLocalStmt) are first recorded
+ * into one buffer per function by Options::SVFIRBuildThreads() workers. The
+ * batch is then committed serially in the given function order, visiting the
+ * remaining instructions in between, so statements and the nodes created
+ * for calls, geps and constant expressions get the same ids as in a serial build.
+ */
+void SVFIRBuilder::buildFunStmts(const std::vector<const Function*>& funs)
+{
+    u32_t numThreads = std::min<u32_t>(std::max<u32_t>(Options::SVFIRBuildThreads(), 1), funs.size());
+    if (numThreads <= 1)
+    {
+        PendingStmtVec noStmts;
+        for (const Function* fun : funs)
+            buildFunStmts(*fun, noStmts, false);
+        return;
+    }
+
+    // Bound the number of buffered statements to a batch of functions
+    u32_t batchSize = 64 * numThreads;
+    std::vector<PendingStmtVec> batchStmts(batchSize);
+    for (u32_t begin = 0; begin < funs.size(); begin += batchSize)
+    {
+        u32_t end = std::min<u32_t>(begin + batchSize, funs.size());
+        std::atomic<u32_t> nextFun(begin);
+        auto worker = [&]()
+        {
+            SVFIRBuilder recorder;
+            for (u32_t i = nextFun++; i < end; i = nextFun++)
+                recorder.recordFunStmts(*funs[i], batchStmts[i - begin]);
+        };
+        std::vector<std::thread> workers;
+        for (u32_t i = 0; i < numThreads; ++i)
+            workers.push_back(std::thread(worker));
+        for (std::thread &w : workers)
+            w.join();
+
+        for (u32_t i = begin; i < end; ++i)
+        {
+            buildFunStmts(*funs[i], batchStmts[i - begin], true);
+            PendingStmtVec().swap(batchStmts[i - begin]);
+        }
+    }
+}
+
+/*!
+ * Add the arguments, return and statements of a function to the SVFIR.
+ * If recorded, the statements of function-local instructions are taken from stmts
+ * (in instruction order) instead of visiting these instructions.
+ */
+void SVFIRBuilder::buildFunStmts(const Function& fun, const PendingStmtVec& stmts, bool recorded)
+{
+    const FunObjVar* svffun = llvmModuleSet()->getFunObjVar(&fun);
+    /// collect return node of function fun
+    if(!fun.isDeclaration())
+    {
+        /// Return SVFIR node will not be created for function which can not
+        /// reach the return instruction due to call to abort(), exit(),
+        /// etc. In 176.gcc of SPEC 2000, function build_objc_string() from
+        /// c-lang.c shows an example when fun.doesNotReturn() evaluates
+        /// to TRUE because of abort().
+        if (fun.doesNotReturn() == false &&
+                fun.getReturnType()->isVoidTy() == false)
+        {
+            pag->addFunRet(svffun,
+                           pag->getValVar(pag->getReturnNode(svffun)));
+        }
+
+        /// To be noted, we do not record arguments which are in declared function without body
+        /// TODO: what about external functions with SVFIR imported by commandline?
+        for (Function::const_arg_iterator I = fun.arg_begin(), E = fun.arg_end();
+                I != E; ++I)
+        {
+            setCurrentLocation(&*I,&fun.getEntryBlock());
+            NodeID argValNodeId = llvmModuleSet()->getValueNode(&*I);
+            // if this is the function does not have caller (e.g. main)
+            // or a dead function, shall we create a black hole address edge for it?
+            // it is (1) too conservative, and (2) make FormalParmVFGNode defined at blackhole address PAGEdge.
+            // if(SVFUtil::ArgInNoCallerFunction(&*I)) {
+            //    if(I->getType()->isPointerTy())
+            //        addBlackHoleAddrEdge(argValNodeId);
+            //}
+            pag->addFunArgs(svffun,pag->getValVar(argValNodeId));
+        }
+    }
+    u32_t nextStmt = 0;
+    for (Function::const_iterator bit = fun.begin(), ebit = fun.end();
+            bit != ebit; ++bit)
+    {
+        const BasicBlock& bb = *bit;
+        for (BasicBlock::const_iterator it = bb.begin(), eit = bb.end();
+                it != eit; ++it)
+        {
+            const Instruction& inst = *it;
+            setCurrentLocation(&inst,&bb);
+            if (recorded && isFunctionLocalStmt(inst))
+            {
+                for (; nextStmt < stmts.size() && stmts[nextStmt].inst == &inst; ++nextStmt)
+                    commitStmt(stmts[nextStmt]);
+            }
+            else
+                visit(const_cast<Instruction&>(inst));
+        }
+    }
+    assert(nextStmt == stmts.size() && "recorded statements not committed?");
+}
+
+/*!
+ * Record the statements of the function-local instructions of a function.
+ * Only this builder's location and buffer are written, so different
+ * functions can be recorded concurrently by different builders.
+ */
+void SVFIRBuilder::recordFunStmts(const Function& fun, PendingStmtVec& stmts)
+{
+    pendingStmts = &stmts;
+    for (const BasicBlock& bb : fun)
+    {
+        for (const Instruction& inst : bb)
+        {
+            if (!isFunctionLocalStmt(inst))
+                continue;
+            setCurrentLocation(&inst, (SVFBasicBlock*) nullptr);
+            visit(const_cast<Instruction&>(inst));
+        }
+    }
+    pendingStmts = nullptr;
+}
+
+/*!
+ * Whether the visitor of an instruction only looks up existing SVFVars and
+ * ICFGNodes and adds statements, i.e. it neither creates nodes (calls, geps,
+ * constant expression operands) nor infers object types.
+ */
+bool SVFIRBuilder::isFunctionLocalStmt(const Instruction& inst)
+{
+    if (!SVFUtil::isa<LoadInst, StoreInst, CastInst, BinaryOperator, UnaryOperator,
+            CmpInst, SelectInst, PHINode>(&inst))
+        return false;
+    // Direct accesses to arrays of pointers are redirected to a field-zero GepValVar
+    if (Options::ModelArrays() && SVFUtil::isa<LoadInst, StoreInst>(&inst) &&
+            !SVFUtil::isa<llvm::GEPOperator>(llvm::getLoadStorePointerOperand(&inst)))
+        return false;
+    for (const Use& op : inst.operands())
+    {
+        if (SVFUtil::isa<ConstantExpr>(op.get()))
+            return false;
+    }
+    return true;
+}
+
+/*!
+ * Add a recorded statement to the SVFIR at the current location
+ */
+void SVFIRBuilder::commitStmt(const PendingStmt& stmt)
+{
+    switch (stmt.kind)
+    {
+    case SVFStmt::Copy:
+        addCopyEdge(stmt.src, stmt.dst, static_cast<CopyStmt::CopyKind>(stmt.opcode));
+        break;
+    case SVFStmt::Load:
+        addLoadEdge(stmt.src, stmt.dst);
+        break;
+    case SVFStmt::Store:
+        addStoreEdge(stmt.src, stmt.dst);
+        break;
+    case SVFStmt::Phi:
+        addPhiStmt(stmt.dst, stmt.src, stmt.pred);
+        break;
+    case SVFStmt::Select:
+        addSelectStmt(stmt.dst, stmt.src, stmt.op2, stmt.cond);
+        break;
+    case SVFStmt::Cmp:
+        addCmpEdge(stmt.src, stmt.op2, stmt.dst, stmt.opcode);
+        break;
+    case SVFStmt::BinaryOp:
+        addBinaryOPEdge(stmt.src, stmt.op2, stmt.dst, stmt.opcode);
+        break;
+    case SVFStmt::UnaryOp:
+        addUnaryOPEdge(stmt.src, stmt.dst, stmt.opcode);
+        break;
+    default:
+        assert(false && "statement kind is not recorded");
+    }
+}
+
+/*!
+ * Dominator, post-dominator, dominance frontier and loop information only read
+ * the LLVM function they are computed for and are written into that function's
+ * own SVFLoopAndDomInfo, so functions are processed concurrently by
+ * Options::SVFIRBuildThreads() workers. The result does not depend on the order.
+ */
+void SVFIRBuilder::initDomTrees(const std::vector<const Function*>& funs)
+{
+    llvmModuleSet()->reserveDomTrees(funs);
+
+    std::atomic<u32_t> nextFun(0);
+    auto worker = [&]()
+    {
+        for (u32_t i = nextFun++; i < funs.size(); i = nextFun++)
+        {
+            FunObjVar* svffun = const_cast<FunObjVar*>(llvmModuleSet()->getFunObjVar(funs[i]));
+            initDomTree(svffun, funs[i]);
+        }
+    };
+
+    u32_t numThreads = std::min<u32_t>(std::max<u32_t>(Options::SVFIRBuildThreads(), 1), funs.size());
+    if (numThreads <= 1)
+    {
+        worker();
+        return;
+    }
+    std::vector<std::thread> workers;
+    for (u32_t i = 0; i < numThreads; ++i)
+        workers.push_back(std::thread(worker));
+    for (std::thread &w : workers)
+        w.join();
+}
+
 void SVFIRBuilder::initDomTree(FunObjVar* svffun, const Function* fun)
 {
     if (fun->isDeclaration())
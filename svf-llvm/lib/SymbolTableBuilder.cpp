@@ -95,6 +95,8 @@ void SymbolTableBuilder::buildMemModel()
     assert(svfir->totalSymNum++ == IRGraph::ConstantObj && "Something changed!");
     createConstantObjTypeInfo(IRGraph::ConstantObj);
 
+    inferHeapObjTypes();
+
     for (Module &M : llvmModuleSet()->getLLVMModules())
     {
         // Add symbols for all the globals .
@@ -613,6 +615,36 @@ const Type* SymbolTableBuilder::inferTypeOfHeapObjOrStaticObj(const Instruction
     return inferedType;
 }
 
+/*!
+ * Collect the start values used by inferTypeOfHeapObjOrStaticObj for every
+ * heap allocation and infer them together, so that allocations reached from
+ * several of them are only walked once
+ */
+void SymbolTableBuilder::inferHeapObjTypes()
+{
+    std::vector<const Value*> startValues;
+    for (Module &M : llvmModuleSet()->getLLVMModules())
+    {
+        for (const Function& fun : M.functions())
+        {
+            for (const Instruction& inst : instructions(fun))
+            {
+                if (LLVMUtil::isHeapAllocExtCallViaRet(&inst))
+                {
+                    startValues.push_back(&inst);
+                }
+                else if (LLVMUtil::isHeapAllocExtCallViaArg(&inst))
+                {
+                    const CallBase* cs = LLVMUtil::getLLVMCallSite(&inst);
+                    u32_t arg_pos = LLVMUtil::getHeapAllocHoldingArgPosition(cs->getCalledFunction());
+                    startValues.push_back(cs->getArgOperand(arg_pos));
+                }
+            }
+        }
+    }
+    getTypeInference()->inferObjTypes(startValues);
+}
+
 /*
  * Initial the memory object here
  */
@@ -869,6 +869,7 @@ int main(int argc, char** argv)
     {
         SymblicAbstractionTest saTest;
         saTest.testsValidation();
+        RelationSolver::printStat();
         return 0;
     }
 
@@ -0,0 +1,135 @@
+//===- extapi-bench.cpp -- Cost of external API queries----------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2022>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * extapi-bench.cpp
+ *
+ *  Times the ExtAPI, ThreadAPI and SaberCheckerAPI queries issued at every call
+ *  site of a module. The ExtAPI queries are run both on the compiled descriptors
+ *  and on the annotation strings (hasExtFuncAnnotation), which is how they were
+ *  answered before the descriptors were introduced.
+ */
+
+#include "SVF-LLVM/LLVMUtil.h"
+#include "SVF-LLVM/SVFIRBuilder.h"
+#include "SABER/SaberCheckerAPI.h"
+#include "Util/CommandLine.h"
+#include "Util/ExtAPI.h"
+#include "Util/Options.h"
+#include "Util/ThreadAPI.h"
+#include <algorithm>
+#include <chrono>
+
+using namespace llvm;
+using namespace std;
+using namespace SVF;
+
+static Option<u32_t> Rounds(
+    "rounds",
+    "number of times every call site is queried",
+    100
+);
+
+/// Run query over all called functions Rounds() times; return the seconds taken
+template <typename Query>
+static double timeQueries(const std::vector<const CallICFGNode*>& callSites, u32_t& hits, Query query)
+{
+    hits = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (u32_t r = 0; r < Rounds(); ++r)
+    {
+        for (const CallICFGNode* cs : callSites)
+        {
+            if (query(cs))
+                hits++;
+        }
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void report(const std::string& name, double secs, u32_t hits, u64_t numQueries)
+{
+    SVFUtil::outs() << name << "\t" << secs << "s\t" << (numQueries ? secs * 1e9 / numQueries : 0)
+                    << "ns/query\thits: " << hits << "\n";
+}
+
+int main(int argc, char ** argv)
+{
+    std::vector<std::string> moduleNameVec;
+    moduleNameVec = OptionBase::parseOptions(
+                        argc, argv, "External API query benchmark", "[options] <input-bitcode...>"
+                    );
+
+    LLVMModuleSet::buildSVFModule(moduleNameVec);
+    SVFIRBuilder builder;
+    SVFIR* pag = builder.build();
+
+    /// direct call sites in id order, so that runs are comparable
+    std::vector<const CallICFGNode*> callSites;
+    for (const CallICFGNode* cs : pag->getCallSiteSet())
+    {
+        if (cs->getCalledFunction())
+            callSites.push_back(cs);
+    }
+    std::sort(callSites.begin(), callSites.end(), [](const CallICFGNode* a, const CallICFGNode* b)
+    {
+        return a->getId() < b->getId();
+    });
+    u64_t numQueries = (u64_t)callSites.size() * Rounds();
+    SVFUtil::outs() << "call sites: " << callSites.size() << "\trounds: " << Rounds() << "\n";
+
+    ExtAPI* extAPI = ExtAPI::getExtAPI();
+    ThreadAPI* tdAPI = ThreadAPI::getThreadAPI();
+    SaberCheckerAPI* ckAPI = SaberCheckerAPI::getCheckerAPI();
+    u32_t hits;
+
+    double secs = timeQueries(callSites, hits, [&](const CallICFGNode* cs)
+    {
+        const FunObjVar* F = cs->getCalledFunction();
+        return extAPI->hasExtFuncAnnotation(F, "ALLOC_HEAP_RET") || extAPI->hasExtFuncAnnotation(F, "ALLOC_HEAP_ARG")
+               || extAPI->hasExtFuncAnnotation(F, "MEMCPY") || extAPI->hasExtFuncAnnotation(F, "STRCPY")
+               || extAPI->hasExtFuncAnnotation(F, "STRCAT") || extAPI->hasExtFuncAnnotation(F, "MEMSET");
+    });
+    report("ExtAPI (annotation strings)", secs, hits, numQueries);
+
+    secs = timeQueries(callSites, hits, [&](const CallICFGNode* cs)
+    {
+        const FunObjVar* F = cs->getCalledFunction();
+        return extAPI->is_alloc(F) || extAPI->is_arg_alloc(F) || extAPI->is_memcpy(F) || extAPI->is_memset(F);
+    });
+    report("ExtAPI (descriptors)", secs, hits, numQueries);
+
+    secs = timeQueries(callSites, hits, [&](const CallICFGNode* cs)
+    {
+        return tdAPI->isTDFork(cs) || tdAPI->isTDJoin(cs);
+    });
+    report("ThreadAPI fork/join", secs, hits, numQueries);
+
+    secs = timeQueries(callSites, hits, [&](const CallICFGNode* cs)
+    {
+        return ckAPI->isMemAlloc(cs) || ckAPI->isMemDealloc(cs);
+    });
+    report("SaberCheckerAPI alloc/dealloc", secs, hits, numQueries);
+
+    LLVMModuleSet::releaseLLVMModuleSet();
+    return 0;
+}
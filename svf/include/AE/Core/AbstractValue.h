@@ -24,27 +24,62 @@
 // Xiao Cheng, Jiawei Wang and Yulei Sui. Precise Sparse Abstract Execution via Cross-Domain Interaction.
 // 46th International Conference on Software Engineering. (ICSE24)
 
+#ifndef INCLUDE_AE_CORE_ABSTRACTVALUE_H_
+#define INCLUDE_AE_CORE_ABSTRACTVALUE_H_
+
 #include "AE/Core/IntervalValue.h"
 #include "AE/Core/AddressValue.h"
 #include "Util/SVFUtil.h"
+#include <atomic>
 
 namespace SVF
 {
 
+/*!
+ * An interval together with a set of addresses.
+ *
+ * Copies of a value share a stamp, taken lazily from a global counter the
+ * first time the value is copied. Any change to the interval or addresses
+ * (including non-const access to them) drops the stamp, so two values with
+ * the same stamp are equal, and equality as well as joins, meets, widenings
+ * and narrowings of a value with an unchanged copy of itself cost one
+ * integer compare.
+ */
 class AbstractValue
 {
-
 public:
+    /// Stamp of a value that has not been copied since its last change
+    static constexpr u64_t NoStamp = 0;
+
+private:
     IntervalValue interval;
     AddressValue addrs;
+    /// Shared by the unchanged copies of this value, or NoStamp
+    mutable u64_t _stamp;
+
+    /// Stamp of this value, assigned on first use
+    inline u64_t shareStamp() const
+    {
+        static std::atomic<u64_t> nextStamp{NoStamp + 1};
+        if (_stamp == NoStamp)
+            _stamp = nextStamp.fetch_add(1, std::memory_order_relaxed);
+        return _stamp;
+    }
 
-    AbstractValue()
+    /// Whether rhs is an unchanged copy of this value
+    inline bool sameStamp(const AbstractValue& rhs) const
+    {
+        return _stamp != NoStamp && _stamp == rhs._stamp;
+    }
+
+public:
+    AbstractValue() : _stamp(NoStamp)
     {
         interval = IntervalValue::bottom();
         addrs = AddressValue();
     }
 
-    AbstractValue(const AbstractValue& other)
+    AbstractValue(const AbstractValue& other) : _stamp(other.shareStamp())
     {
         interval = other.interval;
         addrs = other.addrs;
@@ -59,10 +94,11 @@ public:
         return !addrs.isBottom();
     }
 
-    AbstractValue(AbstractValue &&other)
+    AbstractValue(AbstractValue &&other) : _stamp(other._stamp)
     {
         interval = SVFUtil::move(other.interval);
         addrs = SVFUtil::move(other.addrs);
+        other._stamp = NoStamp;
     }
 
     // operator overload, supporting both interval and address
@@ -70,6 +106,7 @@ public:
     {
         interval = other.interval;
         addrs = other.addrs;
+        _stamp = other.shareStamp();
         return *this;
     }
 
@@ -77,6 +114,7 @@ public:
     {
         interval = SVFUtil::move(other.interval);
         addrs = SVFUtil::move(other.addrs);
+        _stamp = other.shareStamp();
         return *this;
     }
 
@@ -84,6 +122,7 @@ public:
     {
         interval = other;
         addrs = AddressValue();
+        _stamp = NoStamp;
         return *this;
     }
 
@@ -91,15 +130,18 @@ public:
     {
         addrs = other;
         interval = IntervalValue::bottom();
+        _stamp = NoStamp;
         return *this;
     }
 
-    AbstractValue(const IntervalValue& ival) : interval(ival), addrs(AddressValue()) {}
+    AbstractValue(const IntervalValue& ival) : interval(ival), addrs(AddressValue()), _stamp(NoStamp) {}
 
-    AbstractValue(const AddressValue& addr) : interval(IntervalValue::bottom()), addrs(addr) {}
+    AbstractValue(const AddressValue& addr) : interval(IntervalValue::bottom()), addrs(addr), _stamp(NoStamp) {}
 
+    /// Mutable access drops the stamp, as the value may change through the reference
     IntervalValue& getInterval()
     {
+        _stamp = NoStamp;
         return interval;
     }
 
@@ -110,10 +152,11 @@ public:
 
     AddressValue& getAddrs()
     {
+        _stamp = NoStamp;
         return addrs;
     }
 
-    const AddressValue getAddrs() const
+    const AddressValue& getAddrs() const
     {
         return addrs;
     }
@@ -122,31 +165,47 @@ public:
 
     bool equals(const AbstractValue &rhs) const
     {
+        if (sameStamp(rhs))
+            return true;
         return interval.equals(rhs.interval) && addrs.equals(rhs.addrs);
     }
 
+    // All four operations are idempotent, so x op x leaves x (and its stamp) unchanged
+
     void join_with(const AbstractValue &other)
     {
+        if (sameStamp(other))
+            return;
         interval.join_with(other.interval);
         addrs.join_with(other.addrs);
+        _stamp = NoStamp;
     }
 
     void meet_with(const AbstractValue &other)
     {
+        if (sameStamp(other))
+            return;
         interval.meet_with(other.interval);
         addrs.meet_with(other.addrs);
+        _stamp = NoStamp;
     }
 
     void widen_with(const AbstractValue &other)
     {
+        if (sameStamp(other))
+            return;
         interval.widen_with(other.interval);
         // TODO: widen Addrs
+        _stamp = NoStamp;
     }
 
     void narrow_with(const AbstractValue &other)
     {
+        if (sameStamp(other))
+            return;
         interval.narrow_with(other.interval);
         // TODO: narrow Addrs
+        _stamp = NoStamp;
     }
 
     std::string toString() const
@@ -154,4 +213,6 @@ public:
         return "<" + interval.toString() + ", " + addrs.toString() + ">";
     }
 };
-}
\ No newline at end of file
+}
+
+#endif /* INCLUDE_AE_CORE_ABSTRACTVALUE_H_ */
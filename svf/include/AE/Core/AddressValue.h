@@ -40,18 +40,42 @@
 
 
 #include "Util/GeneralType.h"
+#include <algorithm>
 #include <sstream>
 
 namespace SVF
 {
+/*!
+ * A set of virtual memory addresses.
+ *
+ * Addresses are stored by their internal index (the address with AddressMask
+ * stripped). Small sets, which are by far the most common (a single object, a
+ * null pointer), are kept inline as a sorted array; larger sets spill into a
+ * NodeBS so that join, meet and subset checks run word-by-word instead of
+ * element-by-element.
+ */
 class AddressValue
 {
     friend class AbstractState;
     friend class RelExeState;
 public:
     typedef Set<u32_t> AddrSet;
+    class AddrIterator;
+    typedef AddrIterator const_iterator;
+    typedef const_iterator iterator;
+
 private:
-    AddrSet _addrs;
+    /// Maximum number of addresses kept inline before spilling into _bits
+    static constexpr u32_t InlineCapacity = 4;
+
+    /// Sorted internal IDs, valid when !_spilled
+    u32_t _inlineIDs[InlineCapacity];
+    /// Number of valid entries in _inlineIDs
+    u32_t _inlineSize;
+    /// Whether the set lives in _bits instead of _inlineIDs
+    bool _spilled;
+    /// Internal IDs of a large set, valid when _spilled
+    NodeBS _bits;
 
     /// Return the internal index if idx is an address otherwise return the value of idx
     static inline u32_t getInternalID(u32_t idx)
@@ -59,30 +83,107 @@ private:
         return (idx & FlippedAddressMask);
     }
 
+    /// Map an internal index back to its virtual address
+    static inline u32_t getAddrFromInternalID(u32_t id)
+    {
+        return AddressMask + id;
+    }
+
+    /// Return the position of id in _inlineIDs, or the position it would be inserted at
+    inline u32_t inlineLowerBound(u32_t id) const
+    {
+        return std::lower_bound(_inlineIDs, _inlineIDs + _inlineSize, id) - _inlineIDs;
+    }
+
+    inline bool containsID(u32_t id) const
+    {
+        if (_spilled)
+            return _bits.test(id);
+        u32_t pos = inlineLowerBound(id);
+        return pos < _inlineSize && _inlineIDs[pos] == id;
+    }
+
+    /// Move the inline IDs into _bits
+    void spill()
+    {
+        if (_spilled)
+            return;
+        for (u32_t i = 0; i < _inlineSize; ++i)
+            _bits.set(_inlineIDs[i]);
+        _inlineSize = 0;
+        _spilled = true;
+    }
+
+    /// Return true if the id is newly added
+    bool insertID(u32_t id)
+    {
+        if (_spilled)
+            return _bits.test_and_set(id);
+        u32_t pos = inlineLowerBound(id);
+        if (pos < _inlineSize && _inlineIDs[pos] == id)
+            return false;
+        if (_inlineSize < InlineCapacity)
+        {
+            std::copy_backward(_inlineIDs + pos, _inlineIDs + _inlineSize, _inlineIDs + _inlineSize + 1);
+            _inlineIDs[pos] = id;
+            ++_inlineSize;
+            return true;
+        }
+        spill();
+        return _bits.test_and_set(id);
+    }
+
+    void copyFrom(const AddressValue &other)
+    {
+        _spilled = other._spilled;
+        _inlineSize = other._inlineSize;
+        std::copy(other._inlineIDs, other._inlineIDs + other._inlineSize, _inlineIDs);
+        if (_spilled)
+            _bits = other._bits;
+        else
+            _bits.clear();
+    }
+
 public:
     /// Default constructor
-    AddressValue() {}
+    AddressValue() : _inlineSize(0), _spilled(false) {}
 
     /// Constructor
-    AddressValue(const Set<u32_t> &addrs) :  _addrs(addrs) {}
+    AddressValue(const Set<u32_t> &addrs) : _inlineSize(0), _spilled(false)
+    {
+        for (u32_t addr : addrs)
+            insert(addr);
+    }
 
-    AddressValue(u32_t addr) :  _addrs({addr}) {}
+    AddressValue(u32_t addr) : _inlineSize(0), _spilled(false)
+    {
+        insert(addr);
+    }
 
     /// Default destructor
     ~AddressValue() = default;
 
     /// Copy constructor
-    AddressValue(const AddressValue &other) : _addrs(other._addrs) {}
+    AddressValue(const AddressValue &other) : _inlineSize(0), _spilled(false)
+    {
+        copyFrom(other);
+    }
 
     /// Move constructor
-    AddressValue(AddressValue &&other) noexcept: _addrs(std::move(other._addrs)) {}
+    AddressValue(AddressValue &&other) noexcept : _inlineSize(other._inlineSize),
+        _spilled(other._spilled), _bits(std::move(other._bits))
+    {
+        std::copy(other._inlineIDs, other._inlineIDs + other._inlineSize, _inlineIDs);
+        other._inlineSize = 0;
+        other._spilled = false;
+    }
 
     /// Copy operator=
     AddressValue &operator=(const AddressValue &other)
     {
-        if (!this->equals(other))
+        if (this != &other)
         {
-            _addrs = other._addrs;
+            copyFrom(other);
         }
         return *this;
     }
@@ -92,96 +193,140 @@ public:
     {
         if (this != &other)
         {
-            _addrs = std::move(other._addrs);
+            _inlineSize = other._inlineSize;
+            _spilled = other._spilled;
+            std::copy(other._inlineIDs, other._inlineIDs + other._inlineSize, _inlineIDs);
+            _bits = std::move(other._bits);
+            other._inlineSize = 0;
+            other._spilled = false;
         }
         return *this;
     }
 
     bool equals(const AddressValue &rhs) const
     {
-        return _addrs == rhs._addrs;
+        if (_spilled && rhs._spilled)
+            return _bits == rhs._bits;
+        if (!_spilled && !rhs._spilled)
+            return _inlineSize == rhs._inlineSize &&
+                   std::equal(_inlineIDs, _inlineIDs + _inlineSize, rhs._inlineIDs);
+        // A spilled set may have shrunk back to a few elements through meet_with
+        return size() == rhs.size() && isSubsetOf(rhs);
     }
 
-    AddrSet::const_iterator begin() const
+    const_iterator begin() const
     {
-        return _addrs.cbegin();
+        return AddrIterator(this, false);
     }
 
-    AddrSet::const_iterator end() const
+    const_iterator end() const
     {
-        return _addrs.cend();
+        return AddrIterator(this, true);
     }
 
     bool empty() const
     {
-        return _addrs.empty();
+        return _spilled ? _bits.empty() : _inlineSize == 0;
     }
 
     u32_t size() const
     {
-        return _addrs.size();
+        return _spilled ? _bits.count() : _inlineSize;
     }
 
-    std::pair<AddressValue::AddrSet::iterator, bool> insert(u32_t id)
+    /// Return true if addr was not already in the set. Only virtual addresses
+    /// can be represented; any other value (e.g., a plain integer) is not the
+    /// address of an object and is dropped, returning false.
+    bool insert(u32_t addr)
     {
-        return _addrs.insert(id);
-    }
-
-    const AddrSet &getVals() const
-    {
-        return _addrs;
-    }
-
-    void setVals(const AddrSet &vals)
-    {
-        _addrs = vals;
+        if (!isVirtualMemAddress(addr))
+            return false;
+        return insertID(getInternalID(addr));
     }
 
     /// Current AddressValue joins with another AddressValue
     bool join_with(const AddressValue &other)
     {
-        bool changed = false;
-        for (const auto &addr: other)
+        if (other.empty())
+            return false;
+        if (!other._spilled)
         {
-            if (!_addrs.count(addr))
-            {
-                if (insert(addr).second)
-                    changed = true;
-            }
+            bool changed = false;
+            for (u32_t i = 0; i < other._inlineSize; ++i)
+                changed |= insertID(other._inlineIDs[i]);
+            return changed;
         }
-        return changed;
+        spill();
+        return _bits |= other._bits;
     }
 
     /// Return a intersected AddressValue
     bool meet_with(const AddressValue &other)
     {
-        AddrSet s;
-        for (const auto &id: other._addrs)
+        if (_spilled && other._spilled)
+            return _bits &= other._bits;
+
+        if (!_spilled)
         {
-            if (_addrs.find(id) != _addrs.end())
-            {
-                s.insert(id);
-            }
+            u32_t kept = 0;
+            for (u32_t i = 0; i < _inlineSize; ++i)
+                if (other.containsID(_inlineIDs[i]))
+                    _inlineIDs[kept++] = _inlineIDs[i];
+            bool changed = (kept != _inlineSize);
+            _inlineSize = kept;
+            return changed;
         }
-        bool changed = (_addrs != s);
-        _addrs = std::move(s);
-        return changed;
+
+        // this is spilled but other is small: the result fits inline
+        u32_t oldSize = _bits.count();
+        u32_t kept = 0;
+        for (u32_t i = 0; i < other._inlineSize; ++i)
+            if (_bits.test(other._inlineIDs[i]))
+                _inlineIDs[kept++] = other._inlineIDs[i];
+        _bits.clear();
+        _spilled = false;
+        _inlineSize = kept;
+        return kept != oldSize;
     }
 
     /// Return true if the AddressValue contains n
     bool contains(u32_t id) const
     {
-        return _addrs.count(id);
+        return isVirtualMemAddress(id) && containsID(getInternalID(id));
     }
 
     bool hasIntersect(const AddressValue &other) const
     {
-        for (const auto& addr : _addrs)
-            if (other._addrs.count(addr))
+        if (_spilled && other._spilled)
+            return _bits.intersects(other._bits);
+        const AddressValue &small = _spilled ? other : *this;
+        const AddressValue &large = _spilled ? *this : other;
+        for (u32_t i = 0; i < small._inlineSize; ++i)
+            if (large.containsID(small._inlineIDs[i]))
                 return true;
         return false;
     }
 
+    /// Return true if every address of this AddressValue is also in other
+    bool isSubsetOf(const AddressValue &other) const
+    {
+        if (_spilled && other._spilled)
+            return other._bits.contains(_bits);
+        if (_spilled)
+        {
+            if (_bits.count() > other._inlineSize)
+                return false;
+            for (u32_t id : _bits)
+                if (!other.containsID(id))
+                    return false;
+            return true;
+        }
+        for (u32_t i = 0; i < _inlineSize; ++i)
+            if (!other.containsID(_inlineIDs[i]))
+                return false;
+        return true;
+    }
+
     inline bool isBottom() const
     {
         return empty();
@@ -198,7 +343,7 @@ public:
         else
         {
             rawStr << "[";
-            for (auto it = _addrs.begin(), eit = _addrs.end(); it!= eit; ++it)
+            for (auto it = begin(), eit = end(); it!= eit; ++it)
             {
                 rawStr << *it << ", ";
             }
@@ -221,6 +366,59 @@ public:
         return (val & 0xff000000) == AddressMask;
     }
 
+    /// Iterates over the (virtual) addresses of an AddressValue in ascending order
+    class AddrIterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = u32_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const u32_t *;
+        using reference = u32_t;
+
+        AddrIterator(const AddressValue *av, bool end)
+            : av(av), pos(end ? av->_inlineSize : 0), bitIt(end ? av->_bits.end() : av->_bits.begin())
+        {
+        }
+
+        AddrIterator &operator++()
+        {
+            if (av->_spilled)
+                ++bitIt;
+            else
+                ++pos;
+            return *this;
+        }
+
+        AddrIterator operator++(int)
+        {
+            AddrIterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        u32_t operator*() const
+        {
+            return getAddrFromInternalID(av->_spilled ? *bitIt : av->_inlineIDs[pos]);
+        }
+
+        bool operator==(const AddrIterator &rhs) const
+        {
+            return av == rhs.av && pos == rhs.pos && bitIt == rhs.bitIt;
+        }
+
+        bool operator!=(const AddrIterator &rhs) const
+        {
+            return !(*this == rhs);
+        }
+
+    private:
+        const AddressValue *av;
+        /// Index into _inlineIDs when the set is not spilled
+        u32_t pos;
+        /// Position in _bits when the set is spilled
+        NodeBS::iterator bitIt;
+    };
 };
 } // end namespace SVF
 #endif //Z3_EXAMPLE_ADDRESSVALUE_H
@@ -32,12 +32,31 @@
 
 #include "AE/Core/AbstractState.h"
 #include "Util/Z3Expr.h"
+#include <functional>
 
 namespace SVF
 {
 class RelationSolver
 {
 public:
+    /// Symbolic abstraction strategies, used to key the result cache and the statistics
+    enum Strategy
+    {
+        RSYStrategy,
+        BilateralStrategy,
+        BSStrategy,
+        StrategyNum
+    };
+
+    /// Work done by one strategy over all solver instances
+    struct StrategyStat
+    {
+        u32_t numCalls = 0;
+        u32_t numCacheHits = 0;
+        u32_t numChecks = 0;    ///< satisfiability checks issued to Z3
+        double time = 0;        ///< seconds spent solving (cache hits excluded)
+    };
+
     RelationSolver() = default;
 
     /* gamma_hat, beta and abstract_consequence works on
@@ -72,7 +91,9 @@ public:
         return Z3Expr::getContext().real_val(std::to_string(f.getFVal()).c_str());
     }
 
-    /* two optional solvers: RSY and bilateral */
+    /* two optional solvers: RSY and bilateral
+     * Each keeps phi asserted in one solver scope for all of its iterations and
+     * results are memoized per (strategy, domain, phi) across all solver instances. */
 
     AbstractState bilateral(const AbstractState& domain, const Z3Expr &phi, u32_t descend_check = 0);
 
@@ -85,6 +106,45 @@ public:
     void updateMap(Map<u32_t, s32_t>& map, u32_t key, const s32_t& value);
 
     void decide_cpa_ext(const Z3Expr &phi, Map<u32_t, Z3Expr>&, Map<u32_t, s32_t>&, Map<u32_t, s32_t>&, Map<u32_t, s32_t>&, Map<u32_t, s32_t>&);
+
+    /// Statistics of the strategies
+    //@{
+    static inline const StrategyStat& getStrategyStat(Strategy strategy)
+    {
+        return stats[strategy];
+    }
+    static void printStat();
+    //@}
+
+    /// Drop the memoized results; to be called before Z3Expr::releaseContext()
+    static inline void releaseCache()
+    {
+        resultCache.clear();
+    }
+
+private:
+    /// Solve with the given strategy unless the same (domain, phi) was solved before.
+    /// solve clears its argument when the result depends on a timeout and must not be cached.
+    AbstractState solveCached(Strategy strategy, const AbstractState& domain, const Z3Expr& phi,
+                              const std::string& extraKey, const std::function<AbstractState(bool&)>& solve);
+
+    AbstractState bilateralImpl(const AbstractState& domain, const Z3Expr &phi, u32_t descend_check, bool& complete);
+    AbstractState RSYImpl(const AbstractState& domain, const Z3Expr &phi, bool& complete);
+    AbstractState BSImpl(const AbstractState& domain, const Z3Expr &phi);
+
+    /// decide_cpa_ext on a solver whose current scope already asserts phi
+    void decideCpaExt(Map<u32_t, Z3Expr>& L_phi, Map<u32_t, s32_t>& mid_values, Map<u32_t, s32_t>& ret,
+                      Map<u32_t, s32_t>& low_values, Map<u32_t, s32_t>& high_values);
+
+    /// Check the shared solver and count the query against the running strategy
+    z3::check_result check(z3::solver& solver);
+
+    /// Results keyed by strategy, phi's AST id and the domain's intervals; phi is kept alive so its id is not reused.
+    /// Shared by all instances, as solvers are usually created per query.
+    static Map<std::string, std::pair<Z3Expr, AbstractState>> resultCache;
+    Strategy curStrategy = StrategyNum;
+
+    static StrategyStat stats[StrategyNum];
 };
 }
 
@@ -0,0 +1,137 @@
+//===- AEDefUseIndex.h -- Def-use index for sparse Abstract Interpretation ---//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013->  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * AEDefUseIndex.h
+ *
+ * Def-use facts consumed by the sparse Abstract Interpretation modes, built
+ * once per SVFIR: the def-site of every ValVar (semi- and full-sparse) and,
+ * for full-sparse, the ObjVar flows of the SVFG's indirect edges together
+ * with the objects stored at each ICFG node and a branch-independent
+ * classification of each flow's ICFG path. The ObjVar part can be written
+ * to a file and read back, so that later runs need not build the SVFG.
+ */
+
+#ifndef INCLUDE_AE_SVFEXE_AEDEFUSEINDEX_H_
+#define INCLUDE_AE_SVFEXE_AEDEFUSEINDEX_H_
+
+#include "SVFIR/SVFIR.h"
+#include "Graphs/ICFG.h"
+
+namespace SVF
+{
+
+class SVFG;
+class PointerAnalysis;
+
+class AEDefUseIndex
+{
+public:
+    /// Whether a path from a def-site to a use-site exists for every branch state
+    enum PathKind
+    {
+        AlwaysFeasible,     ///< a path of unconditional edges exists
+        NeverFeasible,      ///< no path exists even if every branch is taken
+        BranchDependent     ///< only paths through conditional edges exist
+    };
+
+    /// Indirect value-flow of ObjVars into an ICFG node
+    struct ObjFlow
+    {
+        NodeID src;     ///< ICFG node of the def-site
+        NodeBS pts;     ///< objects labelling the SVFG edge, used for kills
+        NodeBS objs;    ///< pts with base objects expanded to all their fields
+        PathKind kind;  ///< feasibility of the path from src, stores to pts kill it
+    };
+    typedef std::vector<ObjFlow> ObjFlowList;
+
+    explicit AEDefUseIndex(SVFIR* pag);
+
+    /// Node where the value of var is kept in sparse mode
+    inline const ICFGNode* getDefSite(const ValVar* var) const
+    {
+        return var->getId() < defSites.size() ? defSites[var->getId()] : computeDefSite(var);
+    }
+
+    /// Collect the ObjVar flows of the SVFG's indirect edges and precompute their paths
+    void buildObjFlows(const SVFG* svfg);
+
+    /// Whether the ObjVar flows are available (built or read)
+    inline bool hasObjFlows() const
+    {
+        return objFlowsReady;
+    }
+
+    inline const ObjFlowList& getObjFlows(const ICFGNode* node) const
+    {
+        static const ObjFlowList empty;
+        auto it = objFlows.find(node->getId());
+        return it == objFlows.end() ? empty : it->second;
+    }
+
+    /// Objects a store at node may redefine
+    inline const NodeBS& getStoredObjs(const ICFGNode* node) const
+    {
+        static const NodeBS empty;
+        auto it = storedObjs.find(node->getId());
+        return it == storedObjs.end() ? empty : it->second;
+    }
+
+    /// Branch-independent feasibility of an intra-procedural path from src to dst,
+    /// memoized by (src, dst). Paths are not killed by stores.
+    PathKind getPathKind(const ICFGNode* src, const ICFGNode* dst);
+
+    /// Persist the ObjVar part of the index built from pta's SVFG; read returns false
+    /// if the file is missing, malformed, or was written for another SVFIR or pta configuration
+    //@{
+    bool read(const std::string& fileName, const PointerAnalysis* pta);
+    void write(const std::string& fileName, const PointerAnalysis* pta) const;
+    //@}
+
+private:
+    /// Def-site of var as computed without the index
+    const ICFGNode* computeDefSite(const ValVar* var) const;
+
+    /// Classify the path from src to dst, where nodes storing to killPts (if given) end a path
+    PathKind classifyPath(const ICFGNode* src, const ICFGNode* dst, const NodeBS* killPts) const;
+
+    /// Whether dst is reachable from src inside src's function, through conditional edges or not
+    bool reachable(const ICFGNode* src, const ICFGNode* dst, const NodeBS* killPts,
+                   bool throughConditional) const;
+
+    std::string getHeader(const PointerAnalysis* pta) const;
+
+    SVFIR* svfir;
+    ICFG* icfg;
+
+    /// Def-site of each ValVar, indexed by node id
+    std::vector<const ICFGNode*> defSites;
+
+    bool objFlowsReady;
+    Map<NodeID, ObjFlowList> objFlows;
+    Map<NodeID, NodeBS> storedObjs;
+    Map<std::pair<NodeID, NodeID>, PathKind> pathKinds;
+};
+
+} // End namespace SVF
+
+#endif /* INCLUDE_AE_SVFEXE_AEDEFUSEINDEX_H_ */
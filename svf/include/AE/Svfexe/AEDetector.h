@@ -73,9 +73,20 @@ public:
         return detector->getKind() == AEDetector::UNKNOWN;
     }
 
+    /**
+     * @brief Record facts that later checks depend on, on every visit of a node.
+     *
+     * Called while the node is interpreted, so its state may not have
+     * stabilized yet. The default records nothing.
+     * @param node Pointer to the ICFG node.
+     */
+    virtual void collectNodeFacts(const ICFGNode* node) {}
+
     /**
      * @brief Pure virtual function for detecting issues within a node.
-     * @param as Reference to the abstract state.
+     *
+     * Called once the top-level WTO component containing the node has
+     * stabilized, on the final abstract states of that component.
      * @param node Pointer to the ICFG node.
      */
     virtual void detect(const ICFGNode* node) = 0;
@@ -175,9 +186,14 @@ public:
                                     AddressValue objAddrs,
                                     IntervalValue offset);
 
+    /**
+     * @brief Record the offsets of the GEP objects created at a node.
+     * @param node Pointer to the ICFG node.
+     */
+    void collectNodeFacts(const ICFGNode* node) override;
+
     /**
      * @brief Detect buffer overflow issues within a node.
-     * @param as Reference to the abstract state.
      * @param node Pointer to the ICFG node.
      */
     void detect(const ICFGNode*) override;
@@ -48,6 +48,11 @@ public:
         u32_t vmrss, vmsize;
         return SVFUtil::getMemoryUsageKB(&vmrss, &vmsize) ? std::to_string(vmsize) + "KB" : "cannot read memory usage";
     }
+    inline std::string getPeakMemUsage()
+    {
+        u32_t vmrss, vmsize, vmhwm;
+        return SVFUtil::getMemoryUsageKB(&vmrss, &vmsize, &vmhwm) ? std::to_string(vmhwm) + "KB" : "cannot read memory usage";
+    }
 
     void finializeStat();
     void performStat() override;
@@ -57,6 +62,7 @@ public:
     s32_t count{0};
     std::string memory_usage;
     std::string memUsage;
+    std::string peakMemUsage;
 
 
     u32_t& getFunctionTrace()
@@ -83,6 +89,14 @@ public:
         }
         return generalNumMap["ICFG_Node_Trace"];
     }
+    u32_t& getTraceReleaseNum()
+    {
+        if (generalNumMap.count("Trace_Released_State_Num") == 0)
+        {
+            generalNumMap["Trace_Released_State_Num"] = 0;
+        }
+        return generalNumMap["Trace_Released_State_Num"];
+    }
 };
 
 } // namespace SVF
@@ -87,6 +87,13 @@ public:
     }
 
 private:
+    /// Fill the WTOs found in the cache file; the others are appended to pending.
+    /// Returns false if the file is missing or was written for another ICFG.
+    bool readWTOCache(const std::string& fileName, const std::vector<ICFGWTO*>& wtos,
+                      std::vector<ICFGWTO*>& pending);
+    void writeWTOCache(const std::string& fileName, const std::vector<ICFGWTO*>& wtos) const;
+    std::string getWTOCacheHeader() const;
+
     SVFIR* svfir;
     ICFG* icfg;
     AndersenWaveDiff* pta;
@@ -251,6 +251,12 @@ protected:
                                         const ICFGNode* loadIcfg,
                                         const ICFGNode* succ);
 
+    /// Drop the state at `node` once no later analysis step reads it
+    /// (-ae-release-trace).  Dense erases the whole entry; sparse
+    /// subclasses keep what their def-site lookups still need.
+    /// Returns true if anything was released.
+    virtual bool releaseAbsState(const ICFGNode* node);
+
 private:
     /// Initialize abstract state for the global ICFG node and process global
     /// statements
@@ -265,9 +271,29 @@ private:
     /// Handle a function body via worklist-driven WTO traversal starting from funEntry
     void handleFunction(const ICFGNode* funEntry, const CallICFGNode* caller);
 
+    /// Nodes released after each top-level WTO component of a function
+    typedef std::vector<std::vector<const ICFGNode*>> TraceReleasePlan;
+
+    /// Compute (once per function) when each node's state is last read:
+    /// by its intra successors, or as the load behind a branch condition.
+    /// Function entry/exit, call/ret nodes, cycle heads and the sources of
+    /// edges into cycle heads are never released.
+    const TraceReleasePlan& getTraceReleasePlan(const FunObjVar* fun, const ICFGWTO* wto);
+
     /// Handle an ICFG node: execute statements; return true if state changed
     bool handleICFGNode(const ICFGNode* node);
 
+    /// Nodes handled in the current top-level WTO component of one
+    /// handleFunction frame, in first-visit order
+    struct DetectBatch
+    {
+        std::vector<const ICFGNode*> nodes;
+        Set<const ICFGNode*> visited;
+    };
+
+    /// Run the detectors over the nodes of the innermost batch and empty it
+    void runDetectors();
+
     /// Dispatch an SVF statement (Addr/Binary/Cmp/Load/Store/Copy/Gep/Select/Phi/Call/Ret) to its handler
     virtual void handleSVFStatement(const SVFStmt* stmt);
 
@@ -327,9 +353,13 @@ private:
     Map<std::string, std::function<void(const CallICFGNode*)>> func_map;
 
     Set<const ICFGNode*> allAnalyzedNodes; // All nodes ever analyzed (across all entry points)
+    Map<const FunObjVar*, TraceReleasePlan> traceReleasePlans;
     std::string moduleName;
 
     std::vector<std::unique_ptr<AEDetector>> detectors;
+    /// One batch per active handleFunction call; the detectors check a
+    /// batch once its component has stabilized, before states are released
+    std::vector<DetectBatch> detectBatches;
     AbsExtAPI* utils;
 
 protected:
@@ -24,16 +24,12 @@
 #define INCLUDE_AE_SVFEXE_SPARSEABSTRACTINTERPRETATION_H_
 
 #include "AE/Svfexe/AbstractInterpretation.h"
+#include "AE/Svfexe/AEDefUseIndex.h"
 #include <memory>
 
 namespace SVF
 {
 
-class SVFG;
-class SVFGBuilder;
-class IndirectSVFGEdge;
-class VFGNode;
-
 /// Abstract Interpretation for `Options::AESparsity::SemiSparse`.
 ///
 /// ValVars live at their SVFG-style def-sites: reads pull from there,
@@ -44,6 +40,7 @@ class SemiSparseAbstractInterpretation : public AbstractInterpretation
 {
 public:
     SemiSparseAbstractInterpretation()
+        : defUseIndex(std::make_unique<AEDefUseIndex>(svfir))
     {
         preAnalysis->initCycleValVars();
     }
@@ -73,7 +70,14 @@ protected:
 
     void joinStates(AbstractState& dst, const AbstractState& src) override;
 
+    /// Release only the ObjVar map: ValVars stay at their def-sites,
+    /// where reads from any later node still find them.
+    bool releaseAbsState(const ICFGNode* node) override;
+
     const ICFGNode* getICFGNode(const ValVar* var) const;
+
+    /// Def-sites of ValVars and, in full-sparse mode, the ObjVar flows
+    std::unique_ptr<AEDefUseIndex> defUseIndex;
 };
 
 /// Abstract Interpretation for `Options::AESparsity::Sparse` (full-sparse).
@@ -87,7 +91,7 @@ class FullSparseAbstractInterpretation : public SemiSparseAbstractInterpretation
 public:
     FullSparseAbstractInterpretation()
     {
-        buildSVFG();
+        buildObjFlowIndex();
     }
     ~FullSparseAbstractInterpretation() override;
 
@@ -122,23 +126,33 @@ protected:
                                 AbstractState& as, const ICFGNode* loadIcfg,
                                 const ICFGNode* succ) override;
 
+    /// Nothing is released: ObjVar flows pull from def-sites anywhere in
+    /// the program, so no node's state is known to be dead.
+    bool releaseAbsState(const ICFGNode* node) override;
+
 private:
-    /// SVFG-pull helper: walk each VFG node's indirect SVFG in-edges
+    /// SVFG-pull helper: walk the indexed indirect SVFG flows into node
     /// and pull obj values from upstream def-site traces into
     /// trace[node].  Multiple sources (e.g. mphi operands) JOIN.
     void pullObjValueFlows(const ICFGNode* node);
 
-    /// Return whether an indirect SVFG edge should be pulled into dst.
-    /// Besides branch-feasible ICFG reachability, this rejects paths where
-    /// another store to the same points-to object kills the edge's value.
-    bool isIndirectSVFGEdgeFeasible(const IndirectSVFGEdge* edge,
-                                    const VFGNode* dst);
+    /// Return whether an indexed ObjVar flow from src should be pulled into
+    /// dst.  Flows whose path kind was settled when the index was built are
+    /// answered directly; branch-dependent ones search the ICFG, rejecting
+    /// paths where another store to the same object kills the flow's value.
+    bool isObjFlowFeasible(const AEDefUseIndex::ObjFlow& flow,
+                           const ICFGNode* src, const ICFGNode* dst);
 
     /// Return whether a branch-feasible ICFG path exists from src to dst.
     /// Conditional edges are checked with a pure branch-feasibility query,
     /// so path probing does not create branch-refinement side effects.
     bool isICFGPathFeasible(const ICFGNode* src, const ICFGNode* dst);
 
+    /// Branch-aware BFS inside src's function; nodes storing to killPts
+    /// (if given) end a path.
+    bool searchFeasiblePath(const ICFGNode* src, const ICFGNode* dst,
+                            const NodeBS* killPts);
+
     /// Return whether this intra edge is allowed by the current branch state.
     bool isIntraEdgeBranchFeasible(const IntraCFGEdge* edge,
                                    const ICFGNode* src);
@@ -160,15 +174,9 @@ private:
     /// mergeStatesFromPredecessors.
     Map<const ICFGNode*, Map<NodeID, IntervalValue>> refinementTrace;
 
-    /// Build the SVFG on top of the semi-sparse precompute.
-    void buildSVFG();
-
-    /// Owns the SVFG (via SVFGBuilder's internal unique_ptr).  Without
-    /// this, SVFGBuilder would be a local in buildSVFG() and free the
-    /// graph at scope exit, leaving `svfg` dangling.
-    std::unique_ptr<SVFGBuilder> svfgBuilder;
-    /// View pointer into svfgBuilder's graph; non-null after buildSVFG().
-    SVFG* svfg{nullptr};
+    /// Fill the ObjVar flows of defUseIndex, from the -ae-defuse-index file
+    /// if it matches this SVFIR, otherwise from a freshly built SVFG.
+    void buildObjFlowIndex();
 };
 
 } // namespace SVF
@@ -317,6 +317,7 @@ protected:
     virtual inline void buildSVFG(SVFIR* pag)
     {
         _ander = AndersenWaveDiff::createAndersenWaveDiff(pag);
+        svfgBuilder.setOnDemand(Options::SVFGOnDemand());
         _svfg = svfgBuilder.buildPTROnlySVFG(_ander);
         _pag = _svfg->getPAG();
     }
@@ -355,6 +356,8 @@ protected:
         NodeID obj = oldDpm.getCurNodeID();
         if (_pag->isConstantObj(obj))
             return;
+        /// indirect edges of an on-demand SVFG only exist once the functions around node are built
+        getSVFG()->materializeAround(node);
         const SVFGEdgeSet edgeSet(node->getInEdges());
         for (SVFGNode::const_iterator it = edgeSet.begin(), eit = edgeSet.end(); it != eit; ++it)
         {
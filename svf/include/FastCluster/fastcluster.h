@@ -73,7 +73,9 @@ enum hclust_fast_methods
     // median link with the generic algorithm (Müllner, 2011)
     HCLUST_METHOD_MEDIAN = 3,
     // To indicate to try all methods and pick the best.
-    HCLUST_METHOD_SVF_BEST = 4
+    HCLUST_METHOD_SVF_BEST = 4,
+    // Not hierarchical: order objects by weighted MinHash signatures (SVF only, near-linear).
+    HCLUST_METHOD_SVF_MINHASH = 5
 };
 
 
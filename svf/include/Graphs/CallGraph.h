@@ -34,6 +34,8 @@
 #include "SVFIR/SVFValue.h"
 #include "Graphs/ICFG.h"
 #include <set>
+#include <atomic>
+#include <mutex>
 
 namespace SVF
 {
@@ -271,6 +273,19 @@ protected:
     u32_t numOfResolvedIndCallEdge;
     CGEK kind;
 
+    /// Reachability index: transitive closure over the SCC condensation, built on the first query
+    /// and kept up to date when edges are added (rebuilt lazily if a new edge closes a cycle).
+    /// Concurrent queries are safe, the first one builds the index under reachIndexMutex;
+    /// adding nodes or edges still needs exclusive access to the call graph.
+    //@{
+    mutable std::atomic<bool> reachIndexBuilt;
+    mutable std::mutex reachIndexMutex;
+    mutable Map<NodeID, NodeID> reachRep;           ///< node to its SCC representative
+    mutable Map<NodeID, NodeBS> reachClosure;       ///< representative to the representatives it reaches (excluding itself)
+    mutable Map<NodeID, NodeBS> reachReverse;       ///< representative to the representatives reaching it (excluding itself)
+    mutable NodeBS entryReachableReps;              ///< representatives reachable from a program entry function
+    //@}
+
     /// Clean up memory
     void destroy();
 
@@ -297,8 +312,17 @@ protected:
     {
         edge->getDstNode()->addIncomingEdge(edge);
         edge->getSrcNode()->addOutgoingEdge(edge);
+        if (reachIndexBuilt)
+            updateReachIndex(edge->getSrcID(), edge->getDstID());
     }
 
+    /// Build/update the reachability index
+    //@{
+    void ensureReachIndex() const;
+    void buildReachIndex() const;
+    void updateReachIndex(NodeID src, NodeID dst);
+    //@}
+
     /// add direct call graph edge from database [only used this function when loading cgEdges from db results]
     void addDirectCallGraphEdge(CallGraphEdge* cgEdge);
 
@@ -474,6 +498,9 @@ public:
     /// Whether its reachable between two functions
     bool isReachableBetweenFunctions(const FunObjVar* srcFn, const FunObjVar* dstFn) const;
 
+    /// Whether fun is reachable from a program entry function (e.g., main)
+    bool isReachableFromProgEntry(const FunObjVar* fun) const;
+
     /// Dump the graph
     void dump(const std::string& filename);
 
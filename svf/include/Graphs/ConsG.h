@@ -285,6 +285,11 @@ public:
         return (gepIn || gepOut);
     }
 
+    /// Move the edges of a node merged without moving its edges (its rep is
+    /// already set) to the reps of their endpoints, and remove the node.
+    /// Copy/gep edges and addr edges inside the SCC are dropped as in moveEdgesToRepNode.
+    void removeMergedNode(ConstraintNode* node);
+
     /// Check if a given edge is a NormalGepCGEdge with 0 offset.
     inline bool isZeroOffsettedGepCGEdge(ConstraintEdge *edge) const
     {
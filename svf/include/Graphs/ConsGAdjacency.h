@@ -0,0 +1,129 @@
+//===- ConsGAdjacency.h -- Compact adjacency of a constraint graph------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * ConsGAdjacency.h
+ *
+ *  Per-kind adjacency vectors over a ConstraintGraph. Endpoints are resolved
+ *  through the graph's rep map when they are read, so merging a node into its
+ *  rep only appends vectors instead of moving edges between std::sets.
+ */
+
+#ifndef CONSGADJACENCY_H_
+#define CONSGADJACENCY_H_
+
+#include "Graphs/ConsG.h"
+
+namespace SVF
+{
+
+/*!
+ * Compact adjacency of the direct, load and store constraints of a ConstraintGraph.
+ *
+ * Copy edges are kept as vectors of dst NodeIDs with a bitmap of the targets
+ * recorded so far; gep, load and store constraints point to the (immutable)
+ * edges of the initial graph. Entries may name merged nodes and may repeat
+ * after merges; the vectors of a node are compacted (rep-resolved, merged self-loops
+ * dropped, duplicates removed) the first time they are read after a merge.
+ * Callers must still resolve endpoints through sccRepNode(), as a node can be
+ * merged while its rep's vectors are being visited.
+ */
+class ConstraintAdjacency
+{
+
+public:
+    typedef std::vector<NodeID> NodeVector;
+    typedef std::vector<ConstraintEdge*> EdgeVector;
+
+    /// Take a snapshot of the edges of consCG
+    ConstraintAdjacency(ConstraintGraph* g);
+
+    /// Targets of the copy edges of rep, rep-resolved at the last compaction
+    const NodeVector& getCopyOutNodes(NodeID rep);
+    /// Gep edges leaving rep's SCC
+    const EdgeVector& getGepOutEdges(NodeID rep);
+    /// Load edges whose src is in rep's SCC
+    const EdgeVector& getLoadOutEdges(NodeID rep);
+    /// Store edges whose dst is in rep's SCC
+    const EdgeVector& getStoreInEdges(NodeID rep);
+
+    /// Add a copy edge between two reps. Return false if it already exists or is a self-loop.
+    bool addCopyEdge(NodeID srcRep, NodeID dstRep);
+
+    /// Append the adjacency of sub to rep, to be called before sub's rep is set.
+    /// Return true if a non-zero-offset gep edge connects sub and rep's SCC (PWC).
+    bool mergeNode(NodeID sub, NodeID rep);
+
+    /// Detect SCCs over the copy and gep edges between the current reps.
+    /// Return the reps in topological order.
+    NodeStack& detectSCCs();
+
+    inline NodeStack& topoNodeStack()
+    {
+        return topoOrder;
+    }
+
+    /// Members (including itself) of an SCC found by the last detectSCCs()
+    inline const NodeBS& subNodes(NodeID rep)
+    {
+        NodeBS& subs = sccToSubs[rep];
+        subs.set(rep);
+        return subs;
+    }
+
+    /// Write the compacted copy edges back to the constraint graph and move the
+    /// edges of every merged node to its rep, removing the merged nodes.
+    /// The adjacency is empty afterwards.
+    void materialize();
+
+private:
+    struct NodeAdj
+    {
+        NodeVector copyOut;
+        NodeBS copyTargets;     ///< Dedup bitmap of copyOut
+        EdgeVector gepOut;
+        EdgeVector gepIn;       ///< Only used to detect PWCs on merges
+        EdgeVector loadOut;
+        EdgeVector storeIn;
+        u32_t epoch = 0;        ///< Value of mergeEpoch at the last compaction
+    };
+
+    /// Adjacency of a node, created on first access (e.g. for new field objects)
+    inline NodeAdj& adj(NodeID id)
+    {
+        return nodeToAdj[id];
+    }
+
+    /// Resolve the entries of rep's vectors if any node has been merged since
+    /// they were last compacted
+    NodeAdj& compact(NodeID rep);
+
+    ConstraintGraph* consCG;
+    Map<NodeID, NodeAdj> nodeToAdj;
+    u32_t mergeEpoch;           ///< Number of merges so far
+    NodeStack topoOrder;
+    Map<NodeID, NodeBS> sccToSubs;
+};
+
+} // End namespace SVF
+
+#endif /* CONSGADJACENCY_H_ */
@@ -100,6 +100,9 @@ public:
     /// Get a SVFG edge according to src and dst
     ICFGEdge* getICFGEdge(const ICFGNode* src, const ICFGNode* dst, ICFGEdge::ICFGEdgeK kind);
 
+    /// Hash of the node ids and kinds and of the edges, to check that data derived from this ICFG is still valid
+    u64_t getStructureHash() const;
+
     /// Dump graph into dot file
     void dump(const std::string& file, bool simple = false);
 
@@ -106,6 +106,17 @@ protected:
     std::unique_ptr<MemSSA> mssa;
     PointerAnalysis* pta;
 
+    /// On-demand construction (-svfg-on-demand)
+    //@{
+    bool onDemand;
+    u32_t numOnDemandFuns;      ///< functions which could be materialized
+    std::vector<const FunObjVar*> materializedFuns;    ///< in materialization order
+    Set<const FunObjVar*> materializedFunSet;
+    /// indirect calls passed to connectCallerAndCallee, connected once both ends are materialized
+    Map<const FunObjVar*, CallGraphEdge::CallInstSet> indCallSitesOfFun;
+    Map<const CallICFGNode*, CallGraph::FunctionSet> indCalleesOfCallSite;
+    //@}
+
     /// Clean up memory
     void destroy();
 
@@ -198,6 +209,31 @@ public:
     /// Perform statistics
     void performStat();
 
+    /// On-demand construction: memory SSA and address-taken nodes/edges of a function
+    /// are only built the first time a client traverses into the function
+    //@{
+    inline bool isOnDemand() const
+    {
+        return onDemand;
+    }
+    inline bool isMaterialized(const FunObjVar* fun) const
+    {
+        return !onDemand || materializedFunSet.find(fun) != materializedFunSet.end();
+    }
+    inline const std::vector<const FunObjVar*>& getMaterializedFuns() const
+    {
+        return materializedFuns;
+    }
+    inline u32_t getOnDemandFunNum() const
+    {
+        return numOnDemandFuns;
+    }
+    /// Materialize the function of node and its callers/callees, so that all edges of node exist
+    void materializeAround(const SVFGNode* node);
+    /// Materialize a single function and connect it with the materialized ones
+    void materializeFun(const FunObjVar* fun);
+    //@}
+
     /// Has a SVFGNode
     //@{
     inline bool hasActualINSVFGNodes(const CallICFGNode* cs) const
@@ -286,6 +322,12 @@ public:
 
     virtual void writeToFile(const std::string& filename);
     virtual void readFile(const std::string& filename);
+    /// Compact binary encoding, written when -svfg-binary is set and detected by readFile
+    //@{
+    virtual void writeToBinaryFile(const std::string& filename);
+    virtual void readBinaryFile(const std::string& filename);
+    static bool isBinarySVFGFile(const std::string& filename);
+    //@}
     virtual MRVer* getMRVERFromString(const std::string& input);
 
 protected:
@@ -409,6 +451,21 @@ protected:
     /// Connect indirect SVFG edges from global initializers (store) to main function entry
     void connectFromGlobalToProgEntry();
 
+    /// Switch to on-demand construction before buildSVFG
+    void enableOnDemand();
+    /// Per-function counterparts of the methods above, used by materializeFun
+    //@{
+    void addSVFGNodesForAddrTakenVars(const FunObjVar* fun, NodeBS& newNodes);
+    void connectIndirectSVFGEdges(const FunObjVar* fun, const NodeBS& newNodes);
+    //@}
+    /// Call sites invoking fun and callees of cs whose edges are part of the SVFG
+    //@{
+    void getConnectedCallSites(const FunObjVar* fun, CallGraphEdge::CallInstSet& csSet) const;
+    void getConnectedCallees(const CallICFGNode* cs, CallGraph::FunctionSet& callees) const;
+    //@}
+    /// Connect actual-in/out of cs and formal-in/out of callee
+    void connectMSSACallerAndCallee(const CallICFGNode* cs, const FunObjVar* callee, SVFGEdgeSetTy& edges);
+
     /// Add SVFG node
     virtual inline void addSVFGNode(SVFGNode* node, ICFGNode* icfgNode)
     {
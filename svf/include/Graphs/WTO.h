@@ -37,6 +37,8 @@
 #include "SVFIR/SVFType.h"
 #include "SVFIR/SVFValue.h"
 #include <functional>
+#include <deque>
+#include <limits>
 
 namespace SVF
 {
@@ -512,6 +514,10 @@ public:
 
 /*!
  * Weak topological order for GraphT
+ *
+ * Bourdoncle's recursive visit/component algorithm is run on an explicit
+ * stack over dense per-WTO node indices, so arbitrarily deep graphs cannot
+ * overflow the call stack. Components live in arenas owned by the WTO.
  */
 template <typename GraphT> class WTO
 {
@@ -532,57 +538,72 @@ public:
 protected:
     typedef const WTOComponentT* WTOComponentPtr;
     typedef std::list<WTOComponentPtr> WTOComponentRefList;
-    typedef Set<WTOComponentPtr> WTOComponentRefSet;
     typedef Map<const NodeT*, const WTOCycleT*> NodeRefToWTOCycleMap;
     typedef Map<const NodeT*, NodeRefList> NodeRefTONodeRefListMap;
 
     typedef u32_t CycleDepthNumber;
-    typedef Map<const NodeT*, CycleDepthNumber> NodeRefToCycleDepthNumber;
-    typedef std::vector<const NodeT*> Stack;
     typedef std::shared_ptr<GraphTWTOCycleDepth> WTOCycleDepthPtr;
     typedef Map<const NodeT*, WTOCycleDepthPtr> NodeRefToWTOCycleDepthPtr;
 
+    /// Activation record of the explicit visit/component stack
+    struct Frame
+    {
+        u32_t node;                     ///< dense index of the visited node
+        u32_t succPos;                  ///< position of the next successor in _succPool
+        CycleDepthNumber head;          ///< smallest depth-first number reached so far
+        bool loop;                      ///< whether a successor reached back into the stack
+        bool inComponent;               ///< whether the successors are re-visited to build node's cycle
+        WTOComponentRefList* partition; ///< list receiving the component of node
+        WTOComponentRefList body;       ///< components of the cycle headed by node
+    };
+
 public:
     /// Iterator over the components
     typedef typename WTOComponentRefList::const_iterator Iterator;
 
 protected:
     WTOComponentRefList _components;
-    WTOComponentRefSet _allComponents;
+    /// Storage of all components, deques keep their addresses stable
+    std::deque<WTONodeT> _nodeArena;
+    std::deque<WTOCycleT> _cycleArena;
     NodeRefToWTOCycleMap headRefToCycle;
     NodeRefToWTOCycleDepthPtr _nodeToDepth;
-    NodeRefToCycleDepthNumber _nodeToCDN;
-    CycleDepthNumber _num;
-    Stack _stack;
     const NodeT* _entry;
 
+    /// Construction state, released once init() returns
+    //@{
+    Map<const NodeT*, u32_t> _nodeToIndex;
+    std::vector<const NodeT*> _indexToNode;
+    std::vector<CycleDepthNumber> _cdn;
+    std::vector<u32_t> _succBegin;  ///< UINT_MAX until the successors of a node are computed
+    std::vector<u32_t> _succEnd;
+    std::vector<u32_t> _succPool;   ///< successor indices of all nodes, one contiguous run per node
+    std::vector<u32_t> _stack;
+    std::deque<Frame> _frames;
+    CycleDepthNumber _num;
+    //@}
+
 public:
 
     /// Compute the weak topological order of the given graph
-    explicit WTO(const NodeT* entry) : _num(0), _entry(entry)
+    explicit WTO(const NodeT* entry) : _entry(entry), _num(0)
     {
     }
 
-    /// No copy constructor
-    WTO(const WTO& other) = default;
+    /// No copy constructor, components point into the arenas
+    WTO(const WTO& other) = delete;
 
     /// Move constructor
     WTO(WTO&& other) = default;
 
     /// No copy assignment operator
-    WTO& operator=(const WTO& other) = default;
+    WTO& operator=(const WTO& other) = delete;
 
     /// Move assignment operator
     WTO& operator=(WTO&& other) = default;
 
     /// Destructor
-    ~WTO()
-    {
-        for (const auto& component : _allComponents)
-        {
-            delete component;
-        }
-    }
+    virtual ~WTO() = default;
 
     /// Get all wto components in WTO
     const WTOComponentRefList& getWTOComponents() const
@@ -590,6 +611,12 @@ public:
         return _components;
     }
 
+    /// Return the node the order starts from
+    const NodeT* getEntry() const
+    {
+        return _entry;
+    }
+
     /// Begin iterator over the components
     Iterator begin() const
     {
@@ -672,10 +699,83 @@ public:
 
     void init()
     {
-        visit(_entry, _components);
-        _nodeToCDN.clear();
-        _stack.clear();
+        build();
+        releaseConstructionState();
+        buildNodeToDepth();
+    }
+
+    /// Write the order as node ids on one line, a cycle as "( head body... )"
+    void write(std::ostream& out) const
+    {
+        for (const WTOComponentT* c : _components)
+            writeComponent(out, c);
+        out << "\n";
+    }
+
+    /// Rebuild the order from the tokens written by write(); getNode maps an id back to its node.
+    /// Returns false, leaving the WTO empty, if the tokens are malformed or name unknown nodes.
+    bool read(std::istream& in, const std::function<const NodeT*(NodeID)>& getNode)
+    {
+        std::vector<WTOComponentRefList> lists(1);
+        std::vector<const NodeT*> heads;
+        bool expectHead = false;
+        bool ok = true;
+        std::string tok;
+        while (ok && in >> tok)
+        {
+            if (tok == "(")
+            {
+                ok = !expectHead;
+                expectHead = true;
+            }
+            else if (tok == ")")
+            {
+                ok = !expectHead && !heads.empty();
+                if (ok)
+                {
+                    const NodeT* head = heads.back();
+                    heads.pop_back();
+                    WTOComponentRefList body = std::move(lists.back());
+                    lists.pop_back();
+                    const WTOCycleT* cycle = newCycle(newNode(head), std::move(body));
+                    headRefToCycle.emplace(head, cycle);
+                    lists.back().push_back(cycle);
+                }
+            }
+            else
+            {
+                const NodeT* node = nullptr;
+                // at most 10 digits cannot overflow the 64-bit parse; larger values are malformed
+                if (tok.size() <= std::numeric_limits<NodeID>::digits10 + 1
+                        && tok.find_first_not_of("0123456789") == std::string::npos)
+                {
+                    u64_t id = std::stoull(tok);
+                    if (id <= std::numeric_limits<NodeID>::max())
+                        node = getNode(id);
+                }
+                ok = node != nullptr;
+                if (!ok)
+                    break;
+                if (expectHead)
+                {
+                    heads.push_back(node);
+                    lists.emplace_back();
+                    expectHead = false;
+                }
+                else
+                    lists.back().push_back(newNode(node));
+            }
+        }
+        if (!ok || expectHead || !heads.empty())
+        {
+            _nodeArena.clear();
+            _cycleArena.clear();
+            headRefToCycle.clear();
+            return false;
+        }
+        _components = std::move(lists.front());
         buildNodeToDepth();
+        return true;
     }
 
 protected:
@@ -731,131 +831,159 @@ protected:
     }
 
 protected:
-    /// Return the depth-first number of the given node
-    CycleDepthNumber getCDN(const NodeT* n) const
+    /// Return the dense index of the given node, numbering it on first sight
+    u32_t getIndex(const NodeT* n)
     {
-        auto it = _nodeToCDN.find(n);
-        if (it != _nodeToCDN.end())
-        {
-            return it->second;
-        }
-        else
+        auto res = _nodeToIndex.emplace(n, _indexToNode.size());
+        if (res.second)
         {
-            return 0;
+            _indexToNode.push_back(n);
+            _cdn.push_back(0);
+            _succBegin.push_back(UINT_MAX);
+            _succEnd.push_back(UINT_MAX);
         }
+        return res.first->second;
     }
 
-    /// Set the depth-first number of the given node
-    void setCDN(const NodeT* n, const CycleDepthNumber& dfn)
+    /// Append the successor indices of node n to the pool, once per node
+    void computeSuccessors(u32_t n)
     {
-        auto res = _nodeToCDN.insert(std::make_pair(n, dfn));
-        if (!res.second)
-        {
-            (res.first)->second = dfn;
-        }
+        if (_succBegin[n] != UINT_MAX)
+            return;
+        std::vector<const NodeT*> succs = getSuccessors(_indexToNode[n]);
+        u32_t begin = _succPool.size();
+        for (const NodeT* succ : succs)
+            _succPool.push_back(getIndex(succ));
+        _succBegin[n] = begin;
+        _succEnd[n] = _succPool.size();
     }
 
     /// Pop a node from the stack
-    const NodeT* pop()
+    u32_t pop()
     {
         assert(!_stack.empty() && "empty stack");
-        const NodeT* top = _stack.back();
+        u32_t top = _stack.back();
         _stack.pop_back();
         return top;
     }
 
-    /// Push a node on the stack
-    void push(const NodeT* n)
+    /// Enter visit(n, partition): number n and push its frame
+    void pushFrame(u32_t n, WTOComponentRefList* partition)
     {
+        computeSuccessors(n);
         _stack.push_back(n);
+        _num += CycleDepthNumber(1);
+        _cdn[n] = _num;
+        _frames.push_back(Frame{n, _succBegin[n], _num, false, false, partition, {}});
     }
 
     const WTONodeT* newNode(const NodeT* node)
     {
-        const WTONodeT* ptr = new WTONodeT(node);
-        _allComponents.insert(ptr);
-        return ptr;
+        _nodeArena.emplace_back(node);
+        return &_nodeArena.back();
     }
 
     const WTOCycleT* newCycle(const WTONodeT* node,
-                              const WTOComponentRefList& partition)
+                              WTOComponentRefList&& partition)
     {
-        const WTOCycleT* ptr = new WTOCycleT(node, std::move(partition));
-        _allComponents.insert(ptr);
-        return ptr;
+        _cycleArena.emplace_back(node, std::move(partition));
+        return &_cycleArena.back();
     }
 
-    /// Create the cycle component for the given node
-    virtual const WTOCycleT* component(const NodeT* node)
-    {
-        WTOComponentRefList partition;
-
-        for (auto succ: getSuccessors(node))
+    /// Algorithm to build a weak topological order of a graph
+    ///
+    /// A frame first runs visit() over the successors of its node. If the node
+    /// turns out to head a cycle, the same frame then runs component(), which
+    /// re-visits the unnumbered successors into the cycle body. The value a
+    /// finished visit() returns is folded into its caller unless the caller is
+    /// inside component(), where it is ignored.
+    void build()
+    {
+        pushFrame(getIndex(_entry), &_components);
+        while (!_frames.empty())
         {
-            if (getCDN(succ) == 0)
+            Frame& f = _frames.back();
+            bool descended = false;
+            while (!descended && f.succPos < _succEnd[f.node])
             {
-                visit(succ, partition);
+                u32_t succ = _succPool[f.succPos++];
+                CycleDepthNumber succDfn = _cdn[succ];
+                if (succDfn == CycleDepthNumber(0))
+                {
+                    pushFrame(succ, f.inComponent ? &f.body : f.partition);
+                    descended = true;
+                }
+                else if (!f.inComponent && succDfn <= f.head)
+                {
+                    f.head = succDfn;
+                    f.loop = true;
+                }
             }
-        }
-        const WTONodeT* head = newNode(node);
-        const WTOCycleT* ptr = newCycle(head, partition);
-        headRefToCycle.emplace(node, ptr);
-        return ptr;
-    }
-
-    /// Visit the given node
-    ///
-    /// Algorithm to build a weak topological order of a graph
-    virtual CycleDepthNumber visit(const NodeT* node,
-                                   WTOComponentRefList& partition)
-    {
-        CycleDepthNumber head(0);
-        CycleDepthNumber min(0);
-        bool loop;
-
-        push(node);
-        _num += CycleDepthNumber(1);
-        head = _num;
-        setCDN(node, head);
-        loop = false;
+            if (descended)
+                continue;
 
-        for (auto succ: getSuccessors(node))
-        {
-            CycleDepthNumber succ_dfn = getCDN(succ);
-            if (succ_dfn == CycleDepthNumber(0))
+            const NodeT* node = _indexToNode[f.node];
+            if (f.inComponent)
             {
-                min = visit(succ, partition);
+                const WTOCycleT* cycle = newCycle(newNode(node), std::move(f.body));
+                headRefToCycle.emplace(node, cycle);
+                f.partition->push_front(cycle);
             }
-            else
+            else if (f.head == _cdn[f.node])
             {
-                min = succ_dfn;
+                _cdn[f.node] = UINT_MAX;
+                u32_t element = pop();
+                if (f.loop)
+                {
+                    while (element != f.node)
+                    {
+                        _cdn[element] = 0;
+                        element = pop();
+                    }
+                    f.inComponent = true;
+                    f.succPos = _succBegin[f.node];
+                    continue;
+                }
+                f.partition->push_front(newNode(node));
             }
-            if (min <= head)
+
+            CycleDepthNumber min = f.head;
+            _frames.pop_back();
+            if (!_frames.empty() && !_frames.back().inComponent && min <= _frames.back().head)
             {
-                head = min;
-                loop = true;
+                _frames.back().head = min;
+                _frames.back().loop = true;
             }
         }
+    }
 
-        if (head == getCDN(node))
+    /// Free the construction state, which is not needed to query the order
+    void releaseConstructionState()
+    {
+        Map<const NodeT*, u32_t>().swap(_nodeToIndex);
+        std::vector<const NodeT*>().swap(_indexToNode);
+        std::vector<CycleDepthNumber>().swap(_cdn);
+        std::vector<u32_t>().swap(_succBegin);
+        std::vector<u32_t>().swap(_succEnd);
+        std::vector<u32_t>().swap(_succPool);
+        std::vector<u32_t>().swap(_stack);
+        std::deque<Frame>().swap(_frames);
+    }
+
+    static void writeComponent(std::ostream& out, const WTOComponentT* c)
+    {
+        if (c->getKind() == WTOComponentT::Cycle)
         {
-            setCDN(node, UINT_MAX);
-            const NodeT* element = pop();
-            if (loop)
-            {
-                while (element != node)
-                {
-                    setCDN(element, 0);
-                    element = pop();
-                }
-                partition.push_front(component(node));
-            }
-            else
-            {
-                partition.push_front(newNode(node));
-            }
+            const WTOCycleT* cycle = static_cast<const WTOCycleT*>(c);
+            out << "( " << cycle->head()->getICFGNode()->getId() << " ";
+            for (const WTOComponentT* sub : cycle->getWTOComponents())
+                writeComponent(out, sub);
+            out << ") ";
+        }
+        else
+        {
+            out << static_cast<const WTONodeT*>(c)->getICFGNode()->getId() << " ";
         }
-        return head;
     }
 
     /// Build the node to WTO cycle depth table
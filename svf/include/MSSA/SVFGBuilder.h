@@ -51,7 +51,7 @@ public:
 
     /// Constructor
     explicit SVFGBuilder(bool _SVFGWithIndCall = Options::SVFGWithIndirectCall(), bool _SVFGWithPostOpts = Options::OPTSVFG())
-        : svfg(nullptr), SVFGWithIndCall(_SVFGWithIndCall), SVFGWithPostOpts(_SVFGWithPostOpts)
+        : svfg(nullptr), SVFGWithIndCall(_SVFGWithIndCall), SVFGWithPostOpts(_SVFGWithPostOpts), onDemand(false)
     {
     }
 
@@ -82,6 +82,20 @@ public:
     /// Build Memory SSA
     virtual std::unique_ptr<MemSSA> buildMSSA(BVDataPTAImpl* pta, bool ptrOnlyMSSA);
 
+    /// Build the SVFG on demand, for clients which call materializeAround before visiting the edges of a node
+    //@{
+    inline void setOnDemand(bool b)
+    {
+        onDemand = b;
+    }
+    inline bool isOnDemand() const
+    {
+        return onDemand;
+    }
+    //@}
+    /// Materialize the parts of an on-demand SVFG that the edges of node depend on
+    virtual void materializeAround(const SVFGNode* node);
+
 protected:
     /// Create a DDA SVFG. By default actualOut and FormalIN are removed, unless withAOFI is set true.
     SVFG* build(BVDataPTAImpl* pta, VFG::VFGK kind);
@@ -97,6 +111,8 @@ protected:
     bool SVFGWithIndCall;
     /// Build optimised version of SVFG
     bool SVFGWithPostOpts;
+    /// Defer memory SSA and indirect edges of a function until it is first traversed
+    bool onDemand;
 };
 
 } // End namespace SVF
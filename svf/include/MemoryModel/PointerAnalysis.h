@@ -65,6 +65,8 @@ public:
         Andersen_WPA,		///< Andersen PTA
         AndersenSCD_WPA,    ///< Selective cycle detection andersen-style WPA
         AndersenSFR_WPA,    ///< Stride-based field representation
+        AndersenHCD_WPA,    ///< Hybrid cycle detection andersen-style WPA
+        AndersenLCD_WPA,    ///< Lazy cycle detection andersen-style WPA
         AndersenWaveDiff_WPA,	///< Diff wave propagation andersen-style WPA
         Steensgaard_WPA,      ///< Steensgaard PTA
         CSCallString_WPA,	///< Call string based context sensitive WPA
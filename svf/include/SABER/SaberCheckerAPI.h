@@ -60,6 +60,9 @@ public:
 private:
     /// API map, from a string to threadAPI type
     TDAPIMap tdAPIMap;
+    /// Type of each function queried so far, so that every name is looked up only once.
+    /// Filled lazily by the const getType() without locking: queries must not run concurrently.
+    mutable Map<const FunObjVar*, CHECKER_TYPE> funToTypeMap;
 
     /// Constructor
     SaberCheckerAPI ()
@@ -76,13 +79,18 @@ private:
     /// Get the function type of a function
     inline CHECKER_TYPE getType(const FunObjVar* F) const
     {
-        if(F)
-        {
-            TDAPIMap::const_iterator it= tdAPIMap.find(F->getName());
-            if(it != tdAPIMap.end())
-                return it->second;
-        }
-        return CK_DUMMY;
+        if(F == nullptr)
+            return CK_DUMMY;
+        auto cached = funToTypeMap.find(F);
+        if(cached != funToTypeMap.end())
+            return cached->second;
+
+        CHECKER_TYPE type = CK_DUMMY;
+        TDAPIMap::const_iterator it= tdAPIMap.find(F->getName());
+        if(it != tdAPIMap.end())
+            type = it->second;
+        funToTypeMap[F] = type;
+        return type;
     }
 
 public:
@@ -33,7 +33,7 @@
 #include "SVFIR/SVFValue.h"
 #include "Util/WorkList.h"
 #include "Graphs/SVFG.h"
-#include "Util/Z3Expr.h"
+#include "SABER/SaberCondition.h"
 
 
 namespace SVF
@@ -47,7 +47,7 @@ class SaberCondAllocator
 
 public:
 
-    typedef Z3Expr Condition;   /// z3 condition
+    typedef SaberCondition Condition;   /// z3 or ROBDD condition
     typedef Map<u32_t, const ICFGNode*> IndexToTermInstMap; /// id to instruction map for z3
     typedef Map<u32_t,Condition> CondPosMap;		///< map a branch to its Condition
     typedef Map<const SVFBasicBlock*, CondPosMap > BBCondMap;	/// map bb to a Condition
@@ -56,15 +56,15 @@ public:
     typedef Map<const SVFBasicBlock*, Condition> BBToCondMap;	///< map a basic block to its condition during control-flow guard computation
     typedef FIFOWorkList<const SVFBasicBlock*> CFWorkList;	///< worklist for control-flow guard computation
     typedef Map<const SVFGNode*, Set<const SVFGNode*>> SVFGNodeToSVFGNodeSetMap;
+    typedef std::pair<std::pair<const SVFBasicBlock*, const SVFBasicBlock*>, const SVFGNode*> GuardKey; ///< (srcBB, dstBB, evaluated node)
+    typedef Map<GuardKey, Condition> GuardCache;  ///< memoized intra-procedural value-flow guards
 
 
     /// Constructor
     SaberCondAllocator();
 
     /// Destructor
-    virtual ~SaberCondAllocator()
-    {
-    }
+    virtual ~SaberCondAllocator();
     /// Statistics
     //@{
     inline std::string getMemUsage()
@@ -79,6 +79,14 @@ public:
     {
         return totalCondNum;
     }
+    inline u32_t getGuardQueryNum() const
+    {
+        return guardQueryNum;
+    }
+    inline u32_t getGuardHitNum() const
+    {
+        return guardHitNum;
+    }
     //@}
 
     /// Condition operations
@@ -176,6 +184,7 @@ public:
     inline void clearCFCond()
     {
         bbToCondMap.clear();
+        funToCFCondNum.clear();
     }
     /// Set current value for branch condition evaluation
     inline void setCurEvalSVFGNode(const SVFGNode* node)
@@ -218,6 +227,8 @@ public:
         if(it!=bbToCondMap.end() && isEquivalentBranchCond(it->second, cond))
             return false;
 
+        if (it == bbToCondMap.end())
+            funToCFCondNum[bb->getParent()]++;
         bbToCondMap[bb] = cond;
         return true;
     }
@@ -250,6 +261,18 @@ private:
     /// Allocate path condition for every basic block
     virtual void allocateForBB(const SVFBasicBlock& bb);
 
+    /// ComputeIntraVFGGuard, consulting intraGuardCache only if cacheable
+    Condition computeIntraVFGGuard(const SVFBasicBlock* srcBB, const SVFBasicBlock* dstBB, bool cacheable);
+
+    /// Walk the CFG of a function from srcBB to dstBB to compute the guard (uncached)
+    Condition walkIntraVFGGuard(const SVFBasicBlock* srcBB, const SVFBasicBlock* dstBB);
+
+    /// The evaluated SVFG node if the guards of fun depend on it, nullptr otherwise
+    const SVFGNode* getGuardEvalNode(const FunObjVar* fun);
+
+    /// Whether fun has a branch on a comparison against null (see evaluateTestNullLikeExpr)
+    bool hasNullTestBranch(const FunObjVar* fun);
+
     /// Get/Set a branch condition, and its terminator instruction
     //@{
     /// Set branch condition
@@ -291,20 +314,27 @@ private:
     /// Release memory
     void destroy()
     {
-
+        intraGuardCache.clear();
+        funHasNullTest.clear();
     }
 
-    /// extract subexpression from a Z3 expression
+    /// extract the branch literals of a condition (for a BDD, those of one satisfying path)
     void extractSubConds(const Condition &condition, NodeBS &support) const;
 
 
     FunToExitBBsMap funToExitBBsMap;		///< map a function to all its basic blocks calling program exit
     BBToCondMap bbToCondMap;				///< map a basic block to its path condition starting from root
+    Map<const FunObjVar*, u32_t> funToCFCondNum;	///< number of basic blocks of a function in bbToCondMap
+    GuardCache intraGuardCache;				///< intra-procedural guards, kept across slices
+    Map<const FunObjVar*, bool> funHasNullTest;	///< cache of hasNullTestBranch
+    u32_t guardQueryNum{};					///< number of cacheable intra-procedural guard queries
+    u32_t guardHitNum{};					///< number of those answered by intraGuardCache
     const SVFGNode* curEvalSVFGNode{};			///< current llvm value to evaluate branch condition when computing guards
     IndexToTermInstMap idToTermInstMap;     ///key: z3 expression id, value: instruction
     NodeBS negConds;                        ///bit vector for distinguish neg
     std::vector<Condition> conditionVec;          /// vector storing z3expression
     static u32_t totalCondNum; /// a counter for fresh condition
+    static u32_t numAllocators; ///< live allocators; the BDD manager is released with the last one
     SVFGNodeToSVFGNodeSetMap removedSUVFEdges;
 
 protected:
@@ -0,0 +1,160 @@
+//===- SaberCondition.h -- Path conditions of Saber---------------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * SaberCondition.h
+ *
+ * A branch/path condition backed either by a Z3 formula (default) or by a node
+ * of the built-in ROBDD package (-saber-bdd). The engine is chosen once, when the
+ * SaberCondAllocator is created; every condition holds only that engine's representation.
+ */
+
+#ifndef SABERCONDITION_H_
+#define SABERCONDITION_H_
+
+#include "Util/Z3Expr.h"
+#include "Util/BDDExpr.h"
+#include <variant>
+
+namespace SVF
+{
+
+class SaberCondition
+{
+private:
+    std::variant<Z3Expr, BDDExpr> expr;     ///< Z3 formula or ROBDD node, depending on the engine
+    static bool useBDD;                     ///< engine of the run, see selectEngine
+
+public:
+    /// A null condition of the selected engine
+    SaberCondition()
+    {
+        if (isBDD())
+            expr.emplace<BDDExpr>();
+    }
+
+    SaberCondition(const Z3Expr& e) : expr(e)
+    {
+    }
+
+    SaberCondition(const BDDExpr& e) : expr(e)
+    {
+    }
+
+    /// Select the engine of every condition of the run; called once when the
+    /// condition allocator is created, before any condition is built
+    static inline void selectEngine(bool bdd)
+    {
+        useBDD = bdd;
+    }
+
+    /// Whether conditions are ROBDDs rather than Z3 formulas
+    static inline bool isBDD()
+    {
+        return useBDD;
+    }
+
+    inline const Z3Expr& getZ3Expr() const
+    {
+        assert(std::holds_alternative<Z3Expr>(expr) && "not a Z3 condition");
+        return std::get<Z3Expr>(expr);
+    }
+
+    inline const BDDExpr& getBDDExpr() const
+    {
+        assert(std::holds_alternative<BDDExpr>(expr) && "not a BDD condition");
+        return std::get<BDDExpr>(expr);
+    }
+
+    /// Z3 expression id or BDD node index
+    inline u32_t id() const
+    {
+        return isBDD() ? getBDDExpr().id() : getZ3Expr().id();
+    }
+
+    friend bool eq(const SaberCondition& lhs, const SaberCondition& rhs)
+    {
+        if (isBDD())
+            return eq(lhs.getBDDExpr(), rhs.getBDDExpr());
+        return eq(lhs.getZ3Expr(), rhs.getZ3Expr());
+    }
+
+    friend std::ostream& operator<<(std::ostream& out, const SaberCondition& cond)
+    {
+        out << dumpStr(cond);
+        return out;
+    }
+
+    /// A value distinct from every branch condition
+    static inline SaberCondition nullExpr()
+    {
+        if (isBDD())
+            return BDDExpr::nullExpr();
+        return Z3Expr(Z3Expr::nullExpr());
+    }
+
+    static inline SaberCondition getTrueCond()
+    {
+        if (isBDD())
+            return BDDExpr::getTrueCond();
+        return Z3Expr::getTrueCond();
+    }
+
+    static inline SaberCondition getFalseCond()
+    {
+        if (isBDD())
+            return BDDExpr::getFalseCond();
+        return Z3Expr::getFalseCond();
+    }
+
+    static inline SaberCondition NEG(const SaberCondition& cond)
+    {
+        if (isBDD())
+            return BDDExpr::NEG(cond.getBDDExpr());
+        return Z3Expr::NEG(cond.getZ3Expr());
+    }
+
+    static inline SaberCondition AND(const SaberCondition& lhs, const SaberCondition& rhs)
+    {
+        if (isBDD())
+            return BDDExpr::AND(lhs.getBDDExpr(), rhs.getBDDExpr());
+        return Z3Expr::AND(lhs.getZ3Expr(), rhs.getZ3Expr());
+    }
+
+    static inline SaberCondition OR(const SaberCondition& lhs, const SaberCondition& rhs)
+    {
+        if (isBDD())
+            return BDDExpr::OR(lhs.getBDDExpr(), rhs.getBDDExpr());
+        return Z3Expr::OR(lhs.getZ3Expr(), rhs.getZ3Expr());
+    }
+
+    static inline std::string dumpStr(const SaberCondition& cond)
+    {
+        if (isBDD())
+            return BDDExpr::dumpStr(cond.getBDDExpr());
+        return Z3Expr::dumpStr(cond.getZ3Expr());
+    }
+};
+
+} // End namespace SVF
+
+#endif /* SABERCONDITION_H_ */
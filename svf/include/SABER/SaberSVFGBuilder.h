@@ -49,7 +49,7 @@ public:
     typedef FIFOWorkList<NodeID> WorkList;
 
     /// Constructor
-    SaberSVFGBuilder(): SVFGBuilder(true) {}
+    SaberSVFGBuilder(): SVFGBuilder(true), numSUPrunedFuns(0) {}
 
     /// Destructor
     virtual ~SaberSVFGBuilder() {}
@@ -70,6 +70,9 @@ public:
         saberCondAllocator = allocator;
     }
 
+    /// Materialize an on-demand SVFG around node and prune strong-update stores of new functions
+    void materializeAround(const SVFGNode* node) override;
+
 protected:
     /// Re-write create SVFG method
     virtual void buildSVFG();
@@ -86,6 +89,7 @@ protected:
     /// Remove Incoming Edge for strong-update (SU) store instruction
     /// Because the SU node does not receive indirect value
     virtual void rmIncomingEdgeForSUStore(BVDataPTAImpl* pta);
+    void rmIncomingEdgeForSUStore(BVDataPTAImpl* pta, const SVFGNode* node);
 
     /// Add actual parameter SVFGNode for 1st argument of a deallocation like external function
     /// In order to path sensitive leak detection
@@ -107,6 +111,8 @@ protected:
     SVFGNodeSet globSVFGNodes;
 
     SaberCondAllocator* saberCondAllocator;
+    /// Number of materialized functions whose strong-update stores are pruned
+    u32_t numSUPrunedFuns;
 };
 
 } // End namespace SVF
@@ -253,6 +253,8 @@ protected:
     inline void FWProcessCurNode(const DPIm& item) override
     {
         const SVFGNode* node = getNode(item.getCurNodeID());
+        /// the out edges of node are visited next
+        memSSA.materializeAround(node);
         if(isSink(node))
         {
             addSinkToCurSlice(node);
@@ -265,6 +267,7 @@ protected:
     inline void BWProcessCurNode(const DPIm& item) override
     {
         const SVFGNode* node = getNode(item.getCurNodeID());
+        memSSA.materializeAround(node);
         if(isInCurForwardSlice(node))
         {
             addToCurBackwardSlice(node);
@@ -73,6 +73,32 @@ public:
     typedef std::pair<const SVFType*, std::vector<AccessPath>> SVFTypeLocSetsPair;
     typedef Map<NodeID, SVFTypeLocSetsPair> TypeLocSetsMap;
     typedef Map<NodePair,NodeID> NodePairSetMap;
+    typedef std::pair<u32_t, u32_t> StmtRange;  ///< [begin, end) into a flat statement array
+    typedef Map<const FunObjVar*, StmtRange> FunToStmtRangeMap;
+
+    /// A contiguous slice of the finalized statement store, usable in range-based for loops
+    struct StmtSlice
+    {
+        SVFStmtList::const_iterator first;
+        SVFStmtList::const_iterator last;
+
+        inline SVFStmtList::const_iterator begin() const
+        {
+            return first;
+        }
+        inline SVFStmtList::const_iterator end() const
+        {
+            return last;
+        }
+        inline size_t size() const
+        {
+            return last - first;
+        }
+        inline bool empty() const
+        {
+            return first == last;
+        }
+    };
 
 private:
     /// ValueNodes - This map indicates the Node that a particular SVFValue* is
@@ -83,6 +109,7 @@ private:
     TypeLocSetsMap typeLocSetsMap;	///< Map an arg to its base SVFType* and all its field location sets
     OffsetToGepVarMap GepObjVarMap;	///< Map a pair<base,off> to a gep obj node id
     MemObjToFieldsMap memToFieldsMap;	///< Map a mem object id to all its fields
+    NodePairMap heapObjCloneMap;	///< Map a pair<heap obj, call site> to the clone of the heap obj
     SVFStmtSet globSVFStmtSet;	///< Global PAGEdges without control flow information
     PHINodeMap phiNodeMap;	///< A set of phi copy edges
     FParmToCallPEMap fParmToCallPEMap; ///< Map a formal param to its CallPE
@@ -100,6 +127,16 @@ private:
     CallSiteSet callSiteSet; /// all the callsites of a program
     CallGraph* callGraph; /// Callgraph with direct calls only; no change allowed after init and use callgraph in PointerAnalysis for indirect calls)
 
+    /// Finalized statement store, (re)built on demand by buildStmtIndex once statements stop changing
+    //@{
+    bool stmtIndexBuilt;
+    SVFStmtList flatStmts;  ///< statements of all ICFG nodes, grouped by function and then by ICFG node
+    Map<const ICFGNode*, StmtRange> icfgNodeToStmtRange;   ///< ICFG node to its slice of flatStmts
+    FunToStmtRangeMap funToStmtRange;   ///< function to its slice of flatStmts
+    std::vector<SVFStmtList> kindToFlatStmts;   ///< one column per statement kind, in flatStmts order
+    std::vector<FunToStmtRangeMap> kindToFunStmtRange;  ///< function to its slice of each column
+    //@}
+
     static std::unique_ptr<SVFIR> pag;	///< Singleton pattern here to enable instance of SVFIR can only be created once.
     static std::string pagReadFromTxt;
 
@@ -325,6 +362,7 @@ public:
     /// Add a SVFStmt into instruction map
     inline void addToSVFStmtList(ICFGNode* inst, SVFStmt* edge)
     {
+        stmtIndexBuilt = false;
         edge->setICFGNode(inst);
         icfgNode2SVFStmtsMap[inst].push_back(edge);
         if (edge->isPTAEdge())
@@ -430,6 +468,51 @@ public:
     }
     //@}
 
+    /// Finalized statement index: contiguous per-kind columns with function and
+    /// ICFG node ranges, so e.g. all stores of a function are a single slice.
+    /// Functions cover the ICFG nodes of their basic blocks; statements of other
+    /// nodes (e.g. the global ICFG node) only appear in the whole-program slices.
+    /// The index is rebuilt lazily after addToSVFStmtList.
+    //@{
+    void buildStmtIndex();
+    /// All statements of the program on ICFG nodes
+    inline StmtSlice getSVFStmts()
+    {
+        if (!stmtIndexBuilt)
+            buildStmtIndex();
+        return {flatStmts.begin(), flatStmts.end()};
+    }
+    /// All statements of a kind, e.g. all loads
+    inline StmtSlice getSVFStmts(SVFStmt::PEDGEK kind)
+    {
+        if (!stmtIndexBuilt)
+            buildStmtIndex();
+        const SVFStmtList& column = kindToFlatStmts[kind];
+        return {column.begin(), column.end()};
+    }
+    /// All statements in the basic blocks of fun
+    inline StmtSlice getFunSVFStmts(const FunObjVar* fun)
+    {
+        if (!stmtIndexBuilt)
+            buildStmtIndex();
+        return getSlice(flatStmts, funToStmtRange, fun);
+    }
+    /// All statements of a kind in the basic blocks of fun, e.g. all stores of a function
+    inline StmtSlice getFunSVFStmts(SVFStmt::PEDGEK kind, const FunObjVar* fun)
+    {
+        if (!stmtIndexBuilt)
+            buildStmtIndex();
+        return getSlice(kindToFlatStmts[kind], kindToFunStmtRange[kind], fun);
+    }
+    /// All statements of an ICFG node, as a slice of the flat store
+    inline StmtSlice getICFGNodeSVFStmts(const ICFGNode* node)
+    {
+        if (!stmtIndexBuilt)
+            buildStmtIndex();
+        return getSlice(flatStmts, icfgNodeToStmtRange, node);
+    }
+    //@}
+
     /// Node and edge statistics
     //@{
     inline u32_t getFieldValNodeNum() const
@@ -569,6 +652,9 @@ public:
     {
         return addDummyObjNode(NodeIDAllocator::get()->allocateObjectId(), type);
     }
+    /// Get the clone of a heap object allocated at a call site of its
+    /// allocator wrapper, create it if it does not exist
+    NodeID getHeapObjClone(const HeapObjVar* obj, const ICFGNode* callSite);
     /// Whether a node is a valid pointer
     //@{
     bool isValidPointer(NodeID nodeId) const;
@@ -597,6 +683,16 @@ protected:
 
 private:
 
+    /// Slice of list for key, empty if key has no range
+    template<typename Key>
+    static inline StmtSlice getSlice(const SVFStmtList& list, const Map<Key, StmtRange>& ranges, Key key)
+    {
+        typename Map<Key, StmtRange>::const_iterator it = ranges.find(key);
+        if (it == ranges.end())
+            return {list.end(), list.end()};
+        return {list.begin() + it->second.first, list.begin() + it->second.second};
+    }
+
     /// Map a SVFStatement type to a set of corresponding SVF statements
     inline void addToStmt2TypeMap(SVFStmt* edge)
     {
@@ -0,0 +1,303 @@
+//===- BDDExpr.h -- ROBDD conditions----------------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+/*
+ * BDDExpr.h
+ *
+ * A small reduced ordered binary decision diagram (ROBDD) package for
+ * propositional branch conditions. Every boolean function has exactly one
+ * node, so equivalence checking is a comparison of node indices and
+ * satisfiability is a comparison against the false terminal.
+ */
+
+#ifndef BDDEXPR_H_
+#define BDDEXPR_H_
+
+#include "Util/GeneralType.h"
+
+namespace SVF
+{
+
+/*!
+ * Node store of the ROBDD package: a unique table guaranteeing canonicity,
+ * a direct-mapped computed cache for AND/OR/NEG and a mark-and-sweep garbage
+ * collector whose roots are the nodes referenced by live BDDExpr handles.
+ */
+class BDDManager
+{
+public:
+    typedef u32_t NodeRef;
+
+    static constexpr NodeRef FalseNode = 0;
+    static constexpr NodeRef TrueNode = 1;
+    static constexpr NodeRef NullNode = ~0U;    ///< not a boolean function (e.g. "no evaluation")
+
+private:
+    static constexpr u32_t TerminalVar = ~0U;
+
+    struct Node
+    {
+        u32_t var;      ///< decision variable, TerminalVar for the two terminals
+        NodeRef low;    ///< successor when var is false
+        NodeRef high;   ///< successor when var is true
+        NodeRef next;   ///< chain in the unique table bucket
+        u32_t refs;     ///< number of BDDExpr handles referring to this node
+    };
+
+    enum OpKind
+    {
+        OpAnd = 1, OpOr, OpNeg
+    };
+
+    struct CacheEntry
+    {
+        u32_t op;
+        NodeRef lhs;
+        NodeRef rhs;
+        NodeRef res;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<NodeRef> freeNodes;
+    std::vector<NodeRef> buckets;
+    std::vector<CacheEntry> cache;
+    std::vector<bool> marks;
+    u32_t numVars;
+    u32_t gcThreshold;
+    u32_t numGCs;
+
+public:
+    BDDManager();
+
+    /// Create a fresh variable ordered after all existing ones; returns its positive literal
+    NodeRef newVar();
+
+    /// Boolean connectives (canonical results)
+    //@{
+    NodeRef AND(NodeRef lhs, NodeRef rhs);
+    NodeRef OR(NodeRef lhs, NodeRef rhs);
+    NodeRef NEG(NodeRef node);
+    //@}
+
+    /// The literal of variable var (positive or negated); the variable must exist
+    NodeRef getLiteral(u32_t var, bool positive);
+
+    /// Collect the literals along one path from node to the true terminal, as (var, value) pairs
+    void getOnePath(NodeRef node, std::vector<std::pair<u32_t, bool>>& path) const;
+
+    /// Print node as nested if-then-else over variables "c<var>"
+    std::string dumpStr(NodeRef node) const;
+
+    /// Handle reference counting
+    //@{
+    inline void incRef(NodeRef node)
+    {
+        if (node > TrueNode && node != NullNode)
+            nodes[node].refs++;
+    }
+    inline void decRef(NodeRef node)
+    {
+        if (node > TrueNode && node != NullNode)
+        {
+            assert(nodes[node].refs > 0 && "BDD node reference count underflow");
+            nodes[node].refs--;
+        }
+    }
+    //@}
+
+    /// Statistics
+    //@{
+    inline u32_t getVarNum() const
+    {
+        return numVars;
+    }
+    inline u32_t getLiveNodeNum() const
+    {
+        return nodes.size() - freeNodes.size();
+    }
+    inline u32_t getGCNum() const
+    {
+        return numGCs;
+    }
+    //@}
+
+private:
+    /// Return the unique node (var, low, high), creating it if necessary
+    NodeRef mk(u32_t var, NodeRef low, NodeRef high);
+
+    /// Recursive AND/OR without garbage collection
+    NodeRef apply(u32_t op, NodeRef lhs, NodeRef rhs);
+    /// Recursive NEG without garbage collection
+    NodeRef negate(NodeRef node);
+
+    /// Reclaim nodes unreachable from live handles when the table grows past the threshold
+    void maybeGC();
+    void gc();
+
+    inline u32_t hashNode(u32_t var, NodeRef low, NodeRef high) const
+    {
+        u64_t h = ((u64_t) var * 12582917ULL) ^ ((u64_t) low * 4256249ULL) ^ ((u64_t) high * 741457ULL);
+        return (u32_t)(h ^ (h >> 29)) & (buckets.size() - 1);
+    }
+    inline u32_t hashOp(u32_t op, NodeRef lhs, NodeRef rhs) const
+    {
+        u64_t h = ((u64_t) lhs * 2654435761ULL) ^ ((u64_t) rhs * 40503ULL) ^ op;
+        return (u32_t)(h ^ (h >> 31)) & (cache.size() - 1);
+    }
+    void rehash(u32_t numBuckets);
+};
+
+/*!
+ * Reference-counted handle to a node of the global BDDManager. Mirrors the
+ * static interface of Z3Expr so that either can back a branch condition.
+ */
+class BDDExpr
+{
+public:
+    typedef BDDManager::NodeRef NodeRef;
+
+private:
+    static BDDManager* manager;
+    NodeRef node;
+
+public:
+    BDDExpr() : node(BDDManager::NullNode)
+    {
+    }
+
+    explicit BDDExpr(NodeRef n) : node(n)
+    {
+        getManager().incRef(node);
+    }
+
+    BDDExpr(const BDDExpr& rhs) : node(rhs.node)
+    {
+        if (node != BDDManager::NullNode)
+            getManager().incRef(node);
+    }
+
+    ~BDDExpr()
+    {
+        if (manager)
+            manager->decRef(node);
+    }
+
+    inline BDDExpr& operator=(const BDDExpr& rhs)
+    {
+        if (node != rhs.node)
+        {
+            getManager().incRef(rhs.node);
+            getManager().decRef(node);
+            node = rhs.node;
+        }
+        return *this;
+    }
+
+    /// Get the BDD manager, singleton design here to make sure all conditions share one node table
+    static BDDManager& getManager();
+
+    /// Release the BDD manager; all handles must be dead or never used again
+    static void releaseManager();
+
+    /// Node index; equal ids mean equivalent conditions
+    inline u32_t id() const
+    {
+        return node;
+    }
+
+    inline bool isNull() const
+    {
+        return node == BDDManager::NullNode;
+    }
+
+    inline bool isTrue() const
+    {
+        return node == BDDManager::TrueNode;
+    }
+
+    inline bool isFalse() const
+    {
+        return node == BDDManager::FalseNode;
+    }
+
+    friend bool eq(const BDDExpr& lhs, const BDDExpr& rhs)
+    {
+        return lhs.node == rhs.node;
+    }
+
+    friend std::ostream& operator<<(std::ostream& out, const BDDExpr& expr)
+    {
+        out << dumpStr(expr);
+        return out;
+    }
+
+    /// A value distinct from every boolean function
+    static inline BDDExpr nullExpr()
+    {
+        return BDDExpr();
+    }
+
+    /// Return the unique true condition
+    static inline BDDExpr getTrueCond()
+    {
+        return BDDExpr(BDDManager::TrueNode);
+    }
+
+    /// Return the unique false condition
+    static inline BDDExpr getFalseCond()
+    {
+        return BDDExpr(BDDManager::FalseNode);
+    }
+
+    /// Create a fresh decision variable
+    static inline BDDExpr newVar()
+    {
+        return BDDExpr(getManager().newVar());
+    }
+
+    /// compute NEG
+    static inline BDDExpr NEG(const BDDExpr& expr)
+    {
+        return BDDExpr(getManager().NEG(expr.node));
+    }
+
+    /// compute AND, used for branch condition
+    static inline BDDExpr AND(const BDDExpr& lhs, const BDDExpr& rhs)
+    {
+        return BDDExpr(getManager().AND(lhs.node, rhs.node));
+    }
+
+    /// compute OR, used for branch condition
+    static inline BDDExpr OR(const BDDExpr& lhs, const BDDExpr& rhs)
+    {
+        return BDDExpr(getManager().OR(lhs.node, rhs.node));
+    }
+
+    /// output BDD as a string
+    static inline std::string dumpStr(const BDDExpr& expr)
+    {
+        return getManager().dumpStr(expr.node);
+    }
+};
+
+} // End namespace SVF
+
+#endif /* BDDEXPR_H_ */
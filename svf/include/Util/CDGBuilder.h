@@ -31,6 +31,7 @@
 
 #include "Graphs/CDG.h"
 #include "SVFIR/SVFValue.h"
+#include <tuple>
 
 // control dependence builder
 namespace SVF
@@ -38,6 +39,9 @@ namespace SVF
 class CDGBuilder
 {
 public:
+    /// (controlling bb, dependent bb, branch position)
+    typedef std::tuple<const SVFBasicBlock *, const SVFBasicBlock *, s32_t> BBControlDep;
+    typedef std::vector<BBControlDep> BBControlDepList;
 
     /// constructor
     CDGBuilder() : _controlDG(CDG::getCDG())
@@ -71,19 +75,14 @@ private:
                Map<const SVFBasicBlock *, std::vector<const SVFBasicBlock *>> &res);
 
     /// extract nodes between two nodes in pdom tree
-    void
+    static void
     extractNodesBetweenPdomNodes(const SVFBasicBlock *succ, const SVFBasicBlock *LCA,
                                  std::vector<const SVFBasicBlock *> &tgtNodes);
 
+    /// compute the control dependences of one function into deps, touching no shared state
+    static void buildFunControlDependence(const FunObjVar *func, BBControlDepList &deps);
 
-    void dfsNodesBetweenPdomNodes(const SVFBasicBlock *cur,
-                                  const SVFBasicBlock *tgt,
-                                  std::vector<const SVFBasicBlock *> &path,
-                                  std::vector<const SVFBasicBlock *> &tgtNodes,
-                                  SVFLoopAndDomInfo *ld);
-
-
-    s64_t getBBSuccessorBranchID(const SVFBasicBlock *BB, const SVFBasicBlock *Succ);
+    static s64_t getBBSuccessorBranchID(const SVFBasicBlock *BB, const SVFBasicBlock *Succ);
 
 
     /// update map
@@ -49,12 +49,38 @@ class ExtAPI
     friend class SVFIRBuilder;
     friend class GraphDBClient;
 
+public:
+    /// Properties queried by the hot is_xxx methods, set when an annotation contains the name
+    enum ExtFunFlag
+    {
+        EF_MEMCPY = 1 << 0,             ///< MEMCPY, STRCPY or STRCAT
+        EF_MEMSET = 1 << 1,             ///< MEMSET
+        EF_ALLOC_HEAP_RET = 1 << 2,     ///< ALLOC_HEAP_RET
+        EF_ALLOC_HEAP_ARG = 1 << 3,     ///< ALLOC_HEAP_ARG
+        EF_ALLOC_STACK_RET = 1 << 4,    ///< ALLOC_STACK_RET
+        EF_REALLOC_HEAP_RET = 1 << 5,   ///< REALLOC_HEAP_RET
+        EF_OVERWRITE_ONLY = 1 << 6      ///< OVERWRITE is the only annotation
+    };
+
+    /// Annotations of a function compiled into flags and argument positions
+    struct ExtFunDesc
+    {
+        u32_t flags = 0;
+        u32_t numAnnotations = 0;
+        s32_t allocArgPos = -1;     ///< number in the ALLOC_HEAP_ARG annotation, -1 if absent
+    };
+
+    /// Compile annotation strings into a descriptor, shared with LLVMModuleSet
+    static ExtFunDesc compileAnnotations(const std::vector<std::string>& funcAnnotations);
+
 private:
 
     static ExtAPI *extOp;
 
     // Map SVFFunction to its annotations
     Map<const FunObjVar*, std::vector<std::string>> funObjVar2Annotations;
+    /// Map SVFFunction to its compiled annotations, set together with funObjVar2Annotations
+    Map<const FunObjVar*, ExtFunDesc> funObjVar2Desc;
 
     // extapi.bc file path
     static std::string extBcPath;
@@ -109,7 +135,20 @@ public:
 
     bool is_ext(const FunObjVar* funObjVar);
 
+    /// Compiled annotations of (F), empty if it has none
+    inline const ExtFunDesc& getExtFunDesc(const FunObjVar* F) const
+    {
+        static const ExtFunDesc noDesc;
+        auto it = funObjVar2Desc.find(F);
+        return it != funObjVar2Desc.end() ? it->second : noDesc;
+    }
+
 private:
+    inline bool hasExtFunFlag(const FunObjVar* F, u32_t flag) const
+    {
+        return F && (getExtFunDesc(F).flags & flag);
+    }
+
     // Set the annotation of (F)
     void setExtFuncAnnotations(const FunObjVar* fun, const std::vector<std::string>&funcAnnotations);
 };
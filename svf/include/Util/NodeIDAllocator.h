@@ -141,6 +141,7 @@ public:
         static const std::string RegioningTime;
         static const std::string DistanceMatrixTime;
         static const std::string FastClusterTime;
+        static const std::string MinHashTime;
         static const std::string DendrogramTraversalTime;
         static const std::string EvalTime;
         static const std::string TotalTime;
@@ -193,6 +194,15 @@ public:
                                                 const size_t numObjects, const Map<NodeID, unsigned> &nodeMap,
                                                 double &distanceMatrixTime);
 
+        /// Allocates the numObjects objects of a region (regionNodeMap maps 0 to n to the objects,
+        /// nodeMap the reverse) in the order of their weighted MinHash signatures over the points-to
+        /// sets they appear in. Objects sharing small, frequent points-to sets end up close together.
+        /// Linear in the total size of the points-to sets, unlike the distance matrix.
+        static inline void minHashOrder(const std::vector<std::pair<const PointsTo *, unsigned>> &pointsToSets,
+                                        const size_t numObjects, const Map<NodeID, unsigned> &nodeMap,
+                                        const std::vector<NodeID> &regionNodeMap, std::vector<NodeID> &newNodeMap,
+                                        unsigned &allocCounter);
+
         /// Traverses the dendrogram produced by fastcluster, making node o, where o is the nth leaf (per
         /// recursive DFS) map to n. index is the dendrogram node to work off. The traversal should start
         /// at the top, which is the "last" (consider that it is 2D) element of the dendrogram, numObjects - 1.
@@ -147,6 +147,10 @@ public:
 
     static const Option<std::string> WriteSVFG;
     static const Option<std::string> ReadSVFG;
+    static const Option<bool> SVFGBinaryFormat;
+    static const Option<bool> SVFGOnDemand;
+    static const Option<u32_t> SVFGOnDemandMaxFuns;
+    static const Option<u32_t> SVFGEdgeThreads;
 
     // LockAnalysis.cpp
     static const Option<bool> IntraLock;
@@ -178,6 +182,14 @@ public:
     // LLVMModule.cpp
     static const Option<std::string> Graphtxt;
     static Option<bool> SVFMain;
+    static const Option<u32_t> ModuleLoadThreads;
+    static const Option<std::string> ObjTypeCache;
+
+    // SVFIRBuilder.cpp
+    static const Option<u32_t> SVFIRBuildThreads;
+
+    // CDGBuilder.cpp
+    static const Option<u32_t> CDGBuildThreads;
 
     // SymbolTableInfo.cpp
     static const Option<bool> LocMemModel;
@@ -194,6 +206,7 @@ public:
 
     // SaberCondAllocator.cpp
     static const Option<bool> PrintPathCond;
+    static const Option<bool> SaberBDD;
 
     // SaberSVFGBuilder.cpp
     static const Option<bool> CollectExtRetGlobals;
@@ -211,8 +224,13 @@ public:
     static const Option<std::string> ReadAnder;
     static const Option<bool> DiffPts;
     static Option<bool> DetectPWC;
+    static const Option<bool> CompactConsCG;
+    static const Option<u32_t> HeapCloneBudget;
     static const Option<bool> VtableInSVFIR;
 
+    // Steensgaard.cpp
+    static const Option<u32_t> SteensThreads;
+
     // WPAPass.cpp
     static const Option<std::string> ExtAPIPath;
     static const Option<bool> AnderSVFG;
@@ -242,6 +260,10 @@ public:
     // Abstract Execution
     static const OptionMap<u32_t> AESparsity;
     static const OptionMap<u32_t> AEFunEntry;
+    static const Option<u32_t> WTOThreads;
+    static const Option<std::string> WTOCache;
+    static const Option<std::string> AEDefUseIndex;
+    static const Option<bool> AEReleaseTrace;
     static const Option<u32_t> WidenDelay;
     /// recursion handling mode, Default: TOP
     static const OptionMap<u32_t> HandleRecur;
@@ -91,6 +91,8 @@ public:
     virtual void callgraphStat() {}
 
     static double timeOfBuildingLLVMModule;
+    static double timeOfLoadingLLVMModules;
+    static double timeOfLLVMPrePasses;
     static double timeOfBuildingSymbolTable;
     static double timeOfBuildingSVFIR;
 
@@ -95,8 +95,9 @@ std::string  pasMsg(const std::string& msg);
 void reportMemoryUsageKB(const std::string& infor,
                          OutStream& O = SVFUtil::outs());
 
-/// Get memory usage from system file. Return TRUE if succeed.
-bool getMemoryUsageKB(u32_t* vmrss_kb, u32_t* vmsize_kb);
+/// Get memory usage, and the peak resident set size (VmHWM) if vmhwm_kb is given,
+/// from system file. Return TRUE if succeed.
+bool getMemoryUsageKB(u32_t* vmrss_kb, u32_t* vmsize_kb, u32_t* vmhwm_kb = nullptr);
 
 /// Increase the stack size limit
 void increaseStackSize();
@@ -168,6 +169,15 @@ inline NodeBS ptsToNodeBS(const PointsTo &pts)
 typedef OrderedSet<PointsTo, equalPointsTo> PointsToList;
 void dumpPointsToList(const PointsToList& ptl);
 
+/// Scramble x (splitmix64 finalizer); sums of mixed ids give order-independent graph hashes
+inline u64_t mixHash(u64_t x)
+{
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
 /// Return true if it is an llvm intrinsic instruction
 bool isIntrinsicInst(const ICFGNode* inst);
 //@}
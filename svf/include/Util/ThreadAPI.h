@@ -77,6 +77,9 @@ public:
 private:
     /// API map, from a string to threadAPI type
     TDAPIMap tdAPIMap;
+    /// Type of each function queried so far, so that every name is looked up only once.
+    /// Filled lazily by the const getType() without locking: queries must not run concurrently.
+    mutable Map<const FunObjVar*, TD_TYPE> funToTypeMap;
 
     /// Constructor
     ThreadAPI ()
@@ -40,6 +40,7 @@
 #include "WPA/WPASolver.h"
 #include "SVFIR/SVFIR.h"
 #include "Graphs/ConsG.h"
+#include "Graphs/ConsGAdjacency.h"
 #include "Util/Options.h"
 
 namespace SVF
@@ -62,7 +63,7 @@ public:
 
     /// Constructor
     AndersenBase(SVFIR* _pag, PTATY type = Andersen_BASE, bool alias_check = true)
-        :  BVDataPTAImpl(_pag, type, alias_check), consCG(nullptr)
+        :  BVDataPTAImpl(_pag, type, alias_check), consCG(nullptr), heapCloning(false)
     {
         iterationForPrintStat = OnTheFlyIterBudgetForStat;
     }
@@ -73,6 +74,14 @@ public:
     /// Andersen analysis
     virtual void analyze() override;
 
+    /// Let initialize() clone wrapped heap objects (see cloneWrappedHeapObjs).
+    /// Off by default: only clients that read points-to sets from this analysis
+    /// alone may enable it, not those rebuilding them from the SVFIR or an SVFG.
+    inline void setHeapCloning(bool b)
+    {
+        heapCloning = b;
+    }
+
     virtual void solveAndwritePtsToFile(const std::string& filename);
 
     virtual void readPtsFromFile(const std::string& filename);
@@ -112,6 +121,8 @@ public:
                  || pta->getAnalysisTy() == AndersenWaveDiff_WPA
                  || pta->getAnalysisTy() == AndersenSCD_WPA
                  || pta->getAnalysisTy() == AndersenSFR_WPA
+                 || pta->getAnalysisTy() == AndersenHCD_WPA
+                 || pta->getAnalysisTy() == AndersenLCD_WPA
                  || pta->getAnalysisTy() == TypeCPP_WPA
                  || pta->getAnalysisTy() == Steensgaard_WPA);
     }
@@ -160,6 +171,7 @@ public:
     static u32_t numOfProcessedStore;  /// Number of processed Store edge
     static u32_t numOfSfrs;
     static u32_t numOfFieldExpand;
+    static u32_t numOfHeapClones;
 
     static u32_t numOfSCCDetection;
     static double timeOfSCCDetection;
@@ -180,6 +192,15 @@ protected:
     ///< created at an indirect callsite, which invokes
     ///< a heap allocator
     void heapAllocatorViaIndCall(const CallICFGNode* cs, NodePairSet& cpySrcNodes);
+
+    /// Whether wrapped heap objects are cloned, see setHeapCloning
+    bool heapCloning;
+    /// Give each direct call site of an allocator wrapper its own clone of
+    /// the wrapped heap object, within Options::HeapCloneBudget()
+    void cloneWrappedHeapObjs();
+    /// The heap object that only flows to retVar (the unique return of a function)
+    /// through copies, nullptr if the function does anything else with it
+    const HeapObjVar* getWrappedHeapObj(NodeID retVar, const NodeBS& csRets) const;
 };
 
 /*!
@@ -194,14 +215,14 @@ public:
 
     /// Constructor
     Andersen(SVFIR* _pag, PTATY type = Andersen_WPA, bool alias_check = true)
-        :  AndersenBase(_pag, type, alias_check)
+        :  AndersenBase(_pag, type, alias_check), adjacency(nullptr)
     {
     }
 
     /// Destructor
     virtual ~Andersen()
     {
-
+        delete adjacency;
     }
 
     /// Initialize analysis
@@ -230,7 +251,9 @@ public:
         return (pta->getAnalysisTy() == Andersen_WPA
                 || pta->getAnalysisTy() == AndersenWaveDiff_WPA
                 || pta->getAnalysisTy() == AndersenSCD_WPA
-                || pta->getAnalysisTy() == AndersenSFR_WPA);
+                || pta->getAnalysisTy() == AndersenSFR_WPA
+                || pta->getAnalysisTy() == AndersenHCD_WPA
+                || pta->getAnalysisTy() == AndersenLCD_WPA);
     }
     //@}
 
@@ -263,6 +286,10 @@ protected:
 
     CallSite2DummyValPN callsite2DummyValPN;        ///< Map an instruction to a dummy obj which created at an indirect callsite, which invokes a heap allocator
 
+    /// Constraints read by the solver when SCC merges do not move the edges
+    /// of the constraint graph (-compact-cg), nullptr otherwise
+    ConstraintAdjacency* adjacency;
+
     /// Handle diff points-to set.
     virtual inline void computeDiffPts(NodeID id)
     {
@@ -321,7 +348,9 @@ protected:
     /// Add copy edge on constraint graph
     virtual inline bool addCopyEdge(NodeID src, NodeID dst)
     {
-        if (consCG->addCopyCGEdge(src, dst))
+        bool added = adjacency ? adjacency->addCopyEdge(sccRepNode(src), sccRepNode(dst))
+                     : consCG->addCopyCGEdge(src, dst) != nullptr;
+        if (added)
         {
             updatePropaPts(src, dst);
             return true;
@@ -400,6 +429,9 @@ private:
 
     static AndersenWaveDiff* diffWave; // static instance
 
+    /// Objects of each node whose loads and stores have already been resolved
+    Map<NodeID, PointsTo> loadStoreDonePts;
+
 public:
     AndersenWaveDiff(SVFIR* _pag, PTATY type = AndersenWaveDiff_WPA, bool alias_check = true): Andersen(_pag, type, alias_check) {}
 
@@ -422,11 +454,18 @@ public:
     }
 
     virtual void initialize();
+    virtual void finalize() override;
     virtual void solveWorklist();
     virtual void processNode(NodeID nodeId);
     virtual void postProcessNode(NodeID nodeId);
     virtual bool handleLoad(NodeID id, const ConstraintEdge* load);
     virtual bool handleStore(NodeID id, const ConstraintEdge* store);
+    /// Resolve a load/store for the objects in pts only
+    virtual bool handleLoad(const PointsTo& pts, const ConstraintEdge* load);
+    virtual bool handleStore(const PointsTo& pts, const ConstraintEdge* store);
+
+protected:
+    virtual bool mergeSrcToTgt(NodeID srcId, NodeID tgtId) override;
 };
 
 } // End namespace SVF
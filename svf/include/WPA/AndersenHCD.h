@@ -0,0 +1,142 @@
+//===- AndersenHCD.h -- Hybrid/lazy cycle detection for Andersen's analysis--//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * AndersenHCD.h
+ *
+ *  Hybrid cycle detection (HCD) and lazy cycle detection (LCD) from
+ *  "The Ant and the Grasshopper: Fast and Accurate Pointer Analysis for
+ *  Millions of Lines of Code" (Hardekopf and Lin, PLDI'07).
+ */
+
+#ifndef INCLUDE_WPA_ANDERSENHCD_H_
+#define INCLUDE_WPA_ANDERSENHCD_H_
+
+#include "WPA/Andersen.h"
+
+namespace SVF
+{
+
+/*!
+ * Hybrid Cycle Detection Based Andersen Analysis
+ *
+ * Before solving, cycles are searched offline in the initial constraint graph
+ * extended with a ref node *p for each dereference (p --load--> a gives
+ * *p --> a, b --store--> p gives b --> *p). Copy-only cycles are merged
+ * right away. For a cycle through *p, every object pointed to by p is in a
+ * cycle with the cycle's non-ref node r, so the objects of p are merged into
+ * r whenever p is processed, without any online graph traversal.
+ */
+class AndersenHCD : public Andersen
+{
+public:
+    typedef Map<NodeID, NodeBS> NodeToTargetsMap;
+
+protected:
+    /// p -> r for each offline cycle through *p and r
+    NodeToTargetsMap hcdTargets;
+
+public:
+    AndersenHCD(SVFIR* _pag, PTATY type = AndersenHCD_WPA, bool alias_check = true) :
+        Andersen(_pag, type, alias_check)
+    {
+    }
+
+    /// Methods for support type inquiry through isa, cast, and dyn_cast:
+    //@{
+    static inline bool classof(const AndersenHCD *)
+    {
+        return true;
+    }
+    static inline bool classof(const PointerAnalysis *pta)
+    {
+        return (pta->getAnalysisTy() == AndersenHCD_WPA
+                || pta->getAnalysisTy() == AndersenLCD_WPA);
+    }
+    //@}
+
+    virtual void initialize();
+
+    virtual const std::string PTAName() const
+    {
+        return "AndersenHCD";
+    }
+
+protected:
+    /// Offline cycle detection on the initial constraint graph
+    void detectOfflineCycles();
+    /// Merge the objects pointed to by nodeId into the nodes sharing a cycle with *nodeId
+    void mergeRefCycles(NodeID nodeId);
+
+    virtual void processNode(NodeID nodeId);
+    virtual bool mergeSrcToTgt(NodeID nodeId, NodeID newRepId);
+};
+
+/*!
+ * Lazy Cycle Detection on top of HCD
+ *
+ * A copy edge n --> z that propagates nothing while pts(n) == pts(z) hints
+ * at a cycle through n and z; z becomes a candidate of the next SCC
+ * detection, which is run only from candidates. Each edge triggers at most once.
+ */
+class AndersenLCD : public AndersenHCD
+{
+protected:
+    /// Copy edges that have already triggered a cycle detection
+    NodePairSet checkedEdges;
+    /// Nodes to start the next cycle detection from
+    NodeSet lcdCandidates;
+
+public:
+    AndersenLCD(SVFIR* _pag, PTATY type = AndersenLCD_WPA, bool alias_check = true) :
+        AndersenHCD(_pag, type, alias_check)
+    {
+    }
+
+    /// Methods for support type inquiry through isa, cast, and dyn_cast:
+    //@{
+    static inline bool classof(const AndersenLCD *)
+    {
+        return true;
+    }
+    static inline bool classof(const PointerAnalysis *pta)
+    {
+        return pta->getAnalysisTy() == AndersenLCD_WPA;
+    }
+    //@}
+
+    virtual void initialize();
+
+    virtual const std::string PTAName() const
+    {
+        return "AndersenLCD";
+    }
+
+protected:
+    virtual void solveWorklist();
+    virtual NodeStack& SCCDetect();
+    virtual bool processCopy(NodeID node, const ConstraintEdge* edge);
+};
+
+} // End namespace SVF
+
+#endif /* INCLUDE_WPA_ANDERSENHCD_H_ */
@@ -17,12 +17,31 @@ namespace SVF
  */
 typedef WPASolver<ConstraintGraph*> WPAConstraintSolver;
 
+/*!
+ * Classes are merged as a whole: a union moves the points-to set of the absorbed
+ * class to the surviving representative. Andersen::cluster() runs it as the
+ * pre-analysis for object clustering; its call graph is not used to seed
+ * Andersen's, as Andersen's call graph only grows and would keep the coarser edges.
+ */
 class Steensgaard : public AndersenBase
 {
 
 public:
-    typedef Map<NodeID, NodeID> NodeToEquivClassMap;
-    typedef Map<NodeID, Set<NodeID>> NodeToSubsMap;
+    /// Adjacency lists of all constraint nodes in one contiguous array
+    struct EdgeRows
+    {
+        std::vector<u32_t> offsets;     ///< the row of node n is targets[offsets[n], offsets[n+1])
+        std::vector<NodeID> targets;
+
+        inline u32_t rowBegin(NodeID n) const
+        {
+            return n + 1 < offsets.size() ? offsets[n] : 0;
+        }
+        inline u32_t rowEnd(NodeID n) const
+        {
+            return n + 1 < offsets.size() ? offsets[n + 1] : 0;
+        }
+    };
 
     /// Constructor
     Steensgaard(SVFIR* _pag) : AndersenBase(_pag, Steensgaard_WPA, true) {}
@@ -49,6 +68,9 @@ public:
 
     void processAllAddr();
 
+    /// Snapshot the store/load/copy/gep edges of the constraint graph into flat rows
+    void ingestConstraints();
+
     void ecUnion(NodeID id, NodeID ec);
 
     /// Methods for support type inquiry through isa, cast, and dyn_cast:
@@ -87,32 +109,26 @@ public:
     }
 
     /// API for equivalence class operations
-    /// Every constraint node maps to an unique equivalence class EC
-    /// An equivalence class has a set of sub constraint nodes.
+    /// Every constraint node maps to an unique equivalence class EC, kept in a
+    /// union-find forest with union by rank and path halving.
     inline NodeID getEC(NodeID id) const
     {
-        NodeToEquivClassMap::const_iterator it = nodeToECMap.find(id);
-        if (it == nodeToECMap.end())
+        if (id >= ecParent.size())
             return id;
-        else
-            return it->second;
+        while (ecParent[id] != id)
+        {
+            ecParent[id] = ecParent[ecParent[id]];
+            id = ecParent[id];
+        }
+        return id;
     }
     /// Return getEC(id)
     inline NodeID sccRepNode(NodeID id) const override
     {
         return getEC(id);
     }
-    void setEC(NodeID node, NodeID rep);
-
-    inline Set<NodeID>& getSubNodes(NodeID id)
-    {
-        nodeToSubsMap[id].insert(id);
-        return nodeToSubsMap[id];
-    }
-    inline void addSubNode(NodeID node, NodeID sub)
-    {
-        nodeToSubsMap[node].insert(sub);
-    }
+    /// Merge the classes of node and rep; returns the representative of the merged class
+    NodeID setEC(NodeID node, NodeID rep);
 
     /// Add copy edge on constraint graph
     virtual inline bool addCopyEdge(NodeID src, NodeID dst) override
@@ -122,8 +138,11 @@ public:
 
 private:
     static Steensgaard* steens; // static instance
-    NodeToEquivClassMap nodeToECMap;
-    NodeToSubsMap nodeToSubsMap;
+    mutable std::vector<NodeID> ecParent;   ///< union-find parent, indexed by NodeID
+    std::vector<u8_t> ecRank;   ///< upper bound of the tree height of a representative
+    EdgeRows storeSrcs;     ///< srcs of the store edges into each node (*p = q)
+    EdgeRows loadDsts;      ///< dsts of the load edges out of each node (r = *p)
+    EdgeRows directDsts;    ///< dsts of the copy and gep edges out of each node
 };
 
 } // namespace SVF
@@ -226,10 +226,11 @@ void AbstractState::printAbstractState() const
         {
             SVFUtil::outs() << " Value: {";
             u32_t i = 0;
+            const u32_t numAddrs = item.second.getAddrs().size();
             for (const auto& addr: item.second.getAddrs())
             {
                 ++i;
-                if (i < item.second.getAddrs().size())
+                if (i < numAddrs)
                 {
                     SVFUtil::outs() << "0x" << std::hex << addr << ", ";
                 }
@@ -265,10 +266,11 @@ void AbstractState::printAbstractState() const
         {
             SVFUtil::outs() << " Value: {";
             u32_t i = 0;
+            const u32_t numAddrs = item.second.getAddrs().size();
             for (const auto& addr: item.second.getAddrs())
             {
                 ++i;
-                if (i < item.second.getAddrs().size())
+                if (i < numAddrs)
                 {
                     SVFUtil::outs() << "0x" << std::hex << addr << ", ";
                 }
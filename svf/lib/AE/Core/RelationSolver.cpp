@@ -28,25 +28,116 @@
  */
 #include "AE/Core/RelationSolver.h"
 #include <cmath>
+#include <chrono>
 #include "Util/Options.h"
 
 using namespace SVF;
 using namespace SVFUtil;
 
+namespace
+{
+/// A scope of the shared solver which is popped on every exit path
+class SolverScope
+{
+public:
+    explicit SolverScope(z3::solver& s) : solver(s)
+    {
+        solver.push();
+    }
+    ~SolverScope()
+    {
+        solver.pop();
+    }
+
+private:
+    z3::solver& solver;
+};
+}
+
+RelationSolver::StrategyStat RelationSolver::stats[RelationSolver::StrategyNum];
+Map<std::string, std::pair<Z3Expr, AbstractState>> RelationSolver::resultCache;
+
+z3::check_result RelationSolver::check(z3::solver& solver)
+{
+    if (curStrategy != StrategyNum)
+        stats[curStrategy].numChecks++;
+    return solver.check();
+}
+
+AbstractState RelationSolver::solveCached(Strategy strategy, const AbstractState& domain, const Z3Expr& phi,
+        const std::string& extraKey, const std::function<AbstractState(bool&)>& solve)
+{
+    StrategyStat& stat = stats[strategy];
+    stat.numCalls++;
+
+    // intervals in variable order, so that equal domains give equal keys
+    std::vector<std::pair<u32_t, std::string>> intervals;
+    for (const auto& item : domain.getVarToVal())
+        intervals.emplace_back(item.first, item.second.getInterval().toString());
+    std::sort(intervals.begin(), intervals.end());
+    std::string key = std::to_string(strategy) + "|" + std::to_string(phi.id()) + "|" + extraKey;
+    for (const auto& item : intervals)
+        key += "|" + std::to_string(item.first) + ":" + item.second;
+
+    auto it = resultCache.find(key);
+    if (it != resultCache.end())
+    {
+        stat.numCacheHits++;
+        return it->second.second;
+    }
+
+    Strategy prevStrategy = curStrategy;
+    curStrategy = strategy;
+    auto start = std::chrono::steady_clock::now();
+    bool complete = true;
+    AbstractState res = solve(complete);
+    stat.time += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    curStrategy = prevStrategy;
+
+    if (complete)
+        resultCache.emplace(key, std::make_pair(phi, res));
+    return res;
+}
+
+void RelationSolver::printStat()
+{
+    static const char* names[StrategyNum] = {"RSY", "Bilateral", "BS"};
+    SVFUtil::outs() << "****Relation Solver Statistics****\n";
+    for (u32_t i = 0; i < StrategyNum; ++i)
+    {
+        const StrategyStat& stat = stats[i];
+        SVFUtil::outs() << names[i] << "\tcalls: " << stat.numCalls << "\tcache hits: " << stat.numCacheHits
+                        << "\tchecks: " << stat.numChecks << "\ttime: " << stat.time << "s\n";
+    }
+}
+
 AbstractState RelationSolver::bilateral(const AbstractState&domain, const Z3Expr& phi,
                                         u32_t descend_check)
+{
+    return solveCached(BilateralStrategy, domain, phi, std::to_string(descend_check), [&](bool& complete)
+    {
+        return bilateralImpl(domain, phi, descend_check, complete);
+    });
+}
+
+AbstractState RelationSolver::bilateralImpl(const AbstractState&domain, const Z3Expr& phi,
+        u32_t descend_check, bool& complete)
 {
     /// init variables
     AbstractState upper = domain.top();
     AbstractState lower = domain.bottom();
     u32_t meets_in_a_row = 0;
-    z3::solver solver = Z3Expr::getSolver();
+    z3::solver& solver = Z3Expr::getSolver();
     z3::params p(Z3Expr::getContext());
     /// TODO: add option for timeout
     p.set(":timeout", static_cast<unsigned>(600)); // in milliseconds
     solver.set(p);
     AbstractState consequence;
 
+    /// phi stays asserted, and lemmas learned from it accumulate, across all iterations
+    SolverScope phiScope(solver);
+    solver.add(phi.getExpr());
+
     /// start processing
     while (lower != upper)
     {
@@ -59,11 +150,11 @@ AbstractState RelationSolver::bilateral(const AbstractState&domain, const Z3Expr
             consequence = abstract_consequence(lower, upper, domain);
         }
         /// compute domain.model_and(phi, domain.logic_not(domain.gamma_hat(consequence)))
-        Z3Expr rhs = !(gamma_hat(consequence, domain));
+        Z3Expr consequenceExpr = gamma_hat(consequence, domain);
         solver.push();
-        solver.add(phi.getExpr() && rhs.getExpr());
+        solver.add((!consequenceExpr).getExpr());
         Map<u32_t, s32_t> solution;
-        z3::check_result checkRes = solver.check();
+        z3::check_result checkRes = check(solver);
         /// find any solution, which is sat
         if (checkRes == z3::sat)
         {
@@ -99,7 +190,15 @@ AbstractState RelationSolver::bilateral(const AbstractState&domain, const Z3Expr
             {
                 /// for timeout reason return upper
                 if (solver.reason_unknown() == "timeout")
+                {
+                    complete = false;
                     return upper;
+                }
+            }
+            else
+            {
+                /// phi implies the consequence, keep it as a lemma for the later queries
+                solver.add(consequenceExpr.getExpr());
             }
             AbstractState newUpper = domain.top();
             newUpper.meetWith(upper);
@@ -112,6 +211,14 @@ AbstractState RelationSolver::bilateral(const AbstractState&domain, const Z3Expr
 }
 
 AbstractState RelationSolver::RSY(const AbstractState& domain, const Z3Expr& phi)
+{
+    return solveCached(RSYStrategy, domain, phi, "", [&](bool& complete)
+    {
+        return RSYImpl(domain, phi, complete);
+    });
+}
+
+AbstractState RelationSolver::RSYImpl(const AbstractState& domain, const Z3Expr& phi, bool& complete)
 {
     AbstractState lower = domain.bottom();
     z3::solver& solver = Z3Expr::getSolver();
@@ -119,13 +226,17 @@ AbstractState RelationSolver::RSY(const AbstractState& domain, const Z3Expr& phi
     /// TODO: add option for timeout
     p.set(":timeout", static_cast<unsigned>(600)); // in milliseconds
     solver.set(p);
+
+    /// lower only grows, so each blocking clause !gamma_hat(lower) implies the previous
+    /// ones and can stay asserted together with phi instead of being pushed and popped
+    SolverScope phiScope(solver);
+    solver.add(phi.getExpr());
     while (1)
     {
         Z3Expr rhs = !(gamma_hat(lower, domain));
-        solver.push();
-        solver.add(phi.getExpr() && rhs.getExpr());
+        solver.add(rhs.getExpr());
         Map<u32_t, s32_t> solution;
-        z3::check_result checkRes = solver.check();
+        z3::check_result checkRes = check(solver);
         /// find any solution, which is sat
         if (checkRes == z3::sat)
         {
@@ -146,7 +257,6 @@ AbstractState RelationSolver::RSY(const AbstractState& domain, const Z3Expr& phi
                     solution.emplace(item.first, 0);
                 }
             }
-            solver.pop();
             AbstractState newLower = domain.bottom();
             newLower.joinWith(lower);
             newLower.joinWith(beta(solution, domain));
@@ -154,12 +264,14 @@ AbstractState RelationSolver::RSY(const AbstractState& domain, const Z3Expr& phi
         }
         else /// unknown or unsat
         {
-            solver.pop();
             if (checkRes == z3::unknown)
             {
                 /// for timeout reason return upper
                 if (solver.reason_unknown() == "timeout")
+                {
+                    complete = false;
                     return domain.top();
+                }
             }
             break;
         }
@@ -268,6 +380,14 @@ void RelationSolver::updateMap(Map<u32_t, s32_t>& map, u32_t key, const s32_t& v
 }
 
 AbstractState RelationSolver::BS(const AbstractState& domain, const Z3Expr &phi)
+{
+    return solveCached(BSStrategy, domain, phi, "", [&](bool&)
+    {
+        return BSImpl(domain, phi);
+    });
+}
+
+AbstractState RelationSolver::BSImpl(const AbstractState& domain, const Z3Expr &phi)
 {
     /// because key of _varToItvVal is u32_t, -key may out of range for int
     /// so we do key + bias for -key
@@ -344,6 +464,11 @@ AbstractState RelationSolver::BS(const AbstractState& domain, const Z3Expr &phi)
 
 Map<u32_t, s32_t> RelationSolver::BoxedOptSolver(const Z3Expr& phi, Map<u32_t, s32_t>& ret, Map<u32_t, s32_t>& low_values, Map<u32_t, s32_t>& high_values)
 {
+    /// phi is asserted once for all rounds of the search
+    z3::solver& solver = Z3Expr::getSolver();
+    SolverScope phiScope(solver);
+    solver.add(phi.getExpr());
+
     /// this is the S in the original paper
     Map<u32_t, Z3Expr> L_phi;
     Map<u32_t, s32_t> mid_values;
@@ -364,7 +489,7 @@ Map<u32_t, s32_t> RelationSolver::BoxedOptSolver(const Z3Expr& phi, Map<u32_t, s
         if (L_phi.empty())
             break;
         else
-            decide_cpa_ext(phi, L_phi, mid_values, ret, low_values, high_values);
+            decideCpaExt(L_phi, mid_values, ret, low_values, high_values);
     }
     return ret;
 }
@@ -377,17 +502,28 @@ void RelationSolver::decide_cpa_ext(const Z3Expr& phi,
                                     Map<u32_t, s32_t>& low_values,
                                     Map<u32_t, s32_t>& high_values)
 {
+    z3::solver& solver = Z3Expr::getSolver();
+    SolverScope phiScope(solver);
+    solver.add(phi.getExpr());
+    decideCpaExt(L_phi, mid_values, ret, low_values, high_values);
+}
+
+void RelationSolver::decideCpaExt(Map<u32_t, Z3Expr>& L_phi,
+                                  Map<u32_t, s32_t>& mid_values,
+                                  Map<u32_t, s32_t>& ret,
+                                  Map<u32_t, s32_t>& low_values,
+                                  Map<u32_t, s32_t>& high_values)
+{
+    z3::solver& solver = Z3Expr::getSolver();
     while (1)
     {
         Z3Expr join_expr(Z3Expr::getContext().bool_val(false));
         for (const auto& item : L_phi)
             join_expr = (join_expr || item.second);
-        join_expr = (join_expr && phi).simplify();
-        z3::solver& solver = Z3Expr::getSolver();
+        join_expr = join_expr.simplify();
         solver.push();
         solver.add(join_expr.getExpr());
-        Map<u32_t, double> solution;
-        z3::check_result checkRes = solver.check();
+        z3::check_result checkRes = check(solver);
         /// find any solution, which is sat
         if (checkRes == z3::sat)
         {
@@ -397,14 +533,10 @@ void RelationSolver::decide_cpa_ext(const Z3Expr& phi,
             {
                 u32_t id = item.first;
                 int value = m.eval(toIntZ3Expr(id).getExpr()).get_numeral_int();
-                // int value = m.eval(Z3Expr::getContext().int_const(std::to_string(id).c_str())).get_numeral_int();
-                /// id is the var id, value is the solution found for var_id
-                /// add a relation to check if the solution meets phi_id
-                Z3Expr expr = (item.second && toIntZ3Expr(id) == value);
-                solver.push();
-                solver.add(expr.getExpr());
-                // solution meets phi_id
-                if (solver.check() == z3::sat)
+                /// id is the var id, value is the solution found for var_id.
+                /// phi_id is [mid_values[id], high_values[id]], so whether the solution
+                /// meets phi_id is decided by comparing bounds instead of asking the solver
+                if (mid_values.at(id) <= value && value <= high_values.at(id))
                 {
                     updateMap(ret, id, (value));
                     updateMap(low_values, id, ret.at(id) + 1);
@@ -412,11 +544,9 @@ void RelationSolver::decide_cpa_ext(const Z3Expr& phi,
                     s32_t mid = (low_values.at(id) + high_values.at(id) + 1) / 2;
                     updateMap(mid_values, id, mid);
                     Z3Expr v = toIntZ3Expr(id);
-                    // Z3Expr v = Z3Expr::getContext().int_const(std::to_string(id).c_str());
                     Z3Expr expr = (toIntVal(mid_values.at(id)) <= v && v <= toIntVal(high_values.at(id)));
                     L_phi[id] = expr;
                 }
-                solver.pop();
             }
         }
         else /// unknown or unsat, we consider unknown as unsat
@@ -428,4 +558,4 @@ void RelationSolver::decide_cpa_ext(const Z3Expr& phi,
         }
     }
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,326 @@
+//===- AEDefUseIndex.cpp -- Def-use index for sparse Abstract Interpretation -//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013->  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * AEDefUseIndex.cpp
+ */
+
+#include "AE/Svfexe/AEDefUseIndex.h"
+#include "Graphs/SVFG.h"
+#include "MemoryModel/PointerAnalysis.h"
+#include "Util/Options.h"
+#include <deque>
+#include <fstream>
+#include <sstream>
+
+using namespace SVF;
+
+AEDefUseIndex::AEDefUseIndex(SVFIR* pag)
+    : svfir(pag), icfg(pag->getICFG()), objFlowsReady(false)
+{
+    NodeID maxId = 0;
+    for (const auto& item : *svfir)
+        maxId = std::max(maxId, item.first);
+    defSites.assign(maxId + 1, nullptr);
+    for (const auto& item : *svfir)
+    {
+        if (const ValVar* var = SVFUtil::dyn_cast<ValVar>(item.second))
+            defSites[item.first] = computeDefSite(var);
+    }
+}
+
+const ICFGNode* AEDefUseIndex::computeDefSite(const ValVar* var) const
+{
+    // const ValVars are all defined in global node
+    if (!var->getICFGNode())
+    {
+        return icfg->getGlobalICFGNode();
+    }
+    // for return value of callsite, use the ret-site as def-site
+    else if (SVFUtil::isa<CallICFGNode>(var->getICFGNode()) &&
+             SVFUtil::isa<RetValPN>(var))
+    {
+        return SVFUtil::cast<CallICFGNode>(var->getICFGNode())->getRetICFGNode();
+    }
+    // for other ValVars, use their def-site as the node to query abstract
+    // value.
+    else
+    {
+        return var->getICFGNode();
+    }
+}
+
+/*!
+ * One flow per distinct (def-site, points-to) pair of the indirect SVFG
+ * in-edges of the VFG nodes hosted at each ICFG node.
+ */
+void AEDefUseIndex::buildObjFlows(const SVFG* svfg)
+{
+    objFlows.clear();
+    storedObjs.clear();
+
+    // A store kills the objects labelling its indirect out-edges
+    for (const auto& item : *svfg)
+    {
+        const VFGNode* vfgNode = item.second;
+        if (SVFUtil::isa<StoreVFGNode>(vfgNode) && vfgNode->getICFGNode())
+        {
+            NodeBS defs = vfgNode->getDefSVFVars();
+            if (!defs.empty())
+                storedObjs[vfgNode->getICFGNode()->getId()] |= defs;
+        }
+    }
+
+    Map<NodeID, Set<std::pair<NodeID, NodeBS>>> seen;
+    for (const auto& item : *svfg)
+    {
+        const ICFGNode* dst = item.second->getICFGNode();
+        if (!dst)
+            continue;
+        for (const VFGEdge* edge : item.second->getInEdges())
+        {
+            const IndirectSVFGEdge* indEdge = SVFUtil::dyn_cast<IndirectSVFGEdge>(edge);
+            if (!indEdge)
+                continue;
+            const ICFGNode* src = indEdge->getSrcNode()->getICFGNode();
+            assert(src && "SVFG source node must have an ICFG node");
+            if (!seen[dst->getId()].insert(std::make_pair(src->getId(), indEdge->getPointsTo())).second)
+                continue;
+
+            ObjFlow flow;
+            flow.src = src->getId();
+            flow.pts = indEdge->getPointsTo();
+            // BaseObjVar labels are expanded to every sibling field because
+            // Andersen may label a field-sensitive consumer with the base
+            for (NodeID id : flow.pts)
+            {
+                if (const BaseObjVar* base = SVFUtil::dyn_cast<BaseObjVar>(svfir->getGNode(id)))
+                    flow.objs |= svfir->getAllFieldsObjVars(base);
+                else
+                    flow.objs.set(id);
+            }
+            flow.kind = classifyPath(src, dst, &flow.pts);
+            objFlows[dst->getId()].push_back(std::move(flow));
+        }
+    }
+    objFlowsReady = true;
+}
+
+AEDefUseIndex::PathKind AEDefUseIndex::getPathKind(const ICFGNode* src, const ICFGNode* dst)
+{
+    auto key = std::make_pair(src->getId(), dst->getId());
+    auto it = pathKinds.find(key);
+    if (it != pathKinds.end())
+        return it->second;
+    PathKind kind = classifyPath(src, dst, nullptr);
+    pathKinds[key] = kind;
+    return kind;
+}
+
+AEDefUseIndex::PathKind AEDefUseIndex::classifyPath(const ICFGNode* src, const ICFGNode* dst,
+        const NodeBS* killPts) const
+{
+    // Paths are only tracked inside one function; other flows are always taken
+    if (src == dst || !src->getFun() || src->getFun() != dst->getFun())
+        return AlwaysFeasible;
+    if (!reachable(src, dst, killPts, true))
+        return NeverFeasible;
+    if (reachable(src, dst, killPts, false))
+        return AlwaysFeasible;
+    return BranchDependent;
+}
+
+bool AEDefUseIndex::reachable(const ICFGNode* src, const ICFGNode* dst, const NodeBS* killPts,
+                              bool throughConditional) const
+{
+    const FunObjVar* fun = src->getFun();
+    std::deque<const ICFGNode*> worklist;
+    Set<const ICFGNode*> visited;
+    worklist.push_back(src);
+    visited.insert(src);
+
+    auto visit = [&](const ICFGNode* succ)
+    {
+        if (succ == dst)
+            return true;
+        if (visited.insert(succ).second)
+            worklist.push_back(succ);
+        return false;
+    };
+
+    while (!worklist.empty())
+    {
+        const ICFGNode* cur = worklist.front();
+        worklist.pop_front();
+
+        // A path which redefines the killed objects before dst ends here
+        if (killPts && cur != src && getStoredObjs(cur).intersects(*killPts))
+            continue;
+
+        // A call is an intra-procedural summary edge to its ret-site
+        if (const CallICFGNode* call = SVFUtil::dyn_cast<CallICFGNode>(cur))
+        {
+            const ICFGNode* succ = call->getRetICFGNode();
+            if (succ && succ->getFun() == fun && visit(succ))
+                return true;
+        }
+
+        for (const ICFGEdge* edge : cur->getOutEdges())
+        {
+            const IntraCFGEdge* intraEdge = SVFUtil::dyn_cast<IntraCFGEdge>(edge);
+            if (!intraEdge || intraEdge->getDstNode()->getFun() != fun)
+                continue;
+            if (intraEdge->getCondition() && !throughConditional)
+                continue;
+            if (visit(intraEdge->getDstNode()))
+                return true;
+        }
+    }
+    return false;
+}
+
+/*!
+ * Index file format:
+ *   SVF-AE-DEFUSE <SVFIR hash> <ICFG hash> <pta> <options the SVFG depends on>
+ *   S <ICFG node> <stored object ids...>
+ *   F <dst ICFG node> <src ICFG node> <path kind> <#pts> <pts ids...> <expanded object ids...>
+ * The hashes cover every node (id, kind) and edge (src, dst, kind) of the SVFIR and the
+ * ICFG, so an index of another program or of an earlier build of it is not reused.
+ */
+std::string AEDefUseIndex::getHeader(const PointerAnalysis* pta) const
+{
+    u64_t irHash = 0;
+    for (const auto& item : *svfir)
+    {
+        const SVFVar* var = item.second;
+        irHash += SVFUtil::mixHash(((u64_t)var->getId() << 8) | (u64_t)var->getNodeKind());
+        for (const SVFStmt* stmt : var->getOutEdges())
+            irHash += SVFUtil::mixHash(SVFUtil::mixHash(((u64_t)stmt->getSrcID() << 32) | stmt->getDstID())
+                                       ^ (u64_t)stmt->getEdgeKind());
+    }
+    return "SVF-AE-DEFUSE " + std::to_string(irHash) + " " + std::to_string(icfg->getStructureHash()) + " " +
+           pta->PTAName() + " field-limit=" + std::to_string(Options::MaxFieldLimit()) +
+           " model-consts=" + std::to_string(Options::ModelConsts()) +
+           " model-arrays=" + std::to_string(Options::ModelArrays()) +
+           " mem-par=" + std::to_string(Options::MemPar());
+}
+
+bool AEDefUseIndex::read(const std::string& fileName, const PointerAnalysis* pta)
+{
+    std::ifstream in(fileName);
+    if (!in.is_open())
+        return false;
+
+    std::string line;
+    if (!std::getline(in, line) || line != getHeader(pta))
+        return false;
+
+    auto isObj = [this](NodeID id)
+    {
+        return svfir->hasGNode(id) && SVFUtil::isa<ObjVar>(svfir->getGNode(id));
+    };
+
+    Map<NodeID, ObjFlowList> flows;
+    Map<NodeID, NodeBS> stored;
+    while (std::getline(in, line))
+    {
+        std::istringstream ss(line);
+        std::string tag;
+        NodeID node;
+        if (!(ss >> tag >> node) || !icfg->hasGNode(node))
+            return false;
+        NodeID id;
+        if (tag == "S")
+        {
+            NodeBS& objs = stored[node];
+            while (ss >> id)
+            {
+                if (!isObj(id))
+                    return false;
+                objs.set(id);
+            }
+            if (!ss.eof())
+                return false;
+        }
+        else if (tag == "F")
+        {
+            ObjFlow flow;
+            u32_t kind, numPts;
+            if (!(ss >> flow.src >> kind >> numPts) || kind > BranchDependent || !icfg->hasGNode(flow.src))
+                return false;
+            flow.kind = static_cast<PathKind>(kind);
+            for (u32_t i = 0; i < numPts; ++i)
+            {
+                if (!(ss >> id) || !isObj(id))
+                    return false;
+                flow.pts.set(id);
+            }
+            while (ss >> id)
+            {
+                if (!isObj(id))
+                    return false;
+                flow.objs.set(id);
+            }
+            if (!ss.eof())
+                return false;
+            flows[node].push_back(std::move(flow));
+        }
+        else
+            return false;
+    }
+
+    objFlows = std::move(flows);
+    storedObjs = std::move(stored);
+    objFlowsReady = true;
+    return true;
+}
+
+void AEDefUseIndex::write(const std::string& fileName, const PointerAnalysis* pta) const
+{
+    std::ofstream out(fileName);
+    if (!out.is_open())
+    {
+        SVFUtil::errs() << "Unable to write def-use index " << fileName << "\n";
+        return;
+    }
+
+    out << getHeader(pta) << "\n";
+    for (const auto& item : storedObjs)
+    {
+        out << "S " << item.first;
+        for (NodeID id : item.second)
+            out << " " << id;
+        out << "\n";
+    }
+    for (const auto& item : objFlows)
+    {
+        for (const ObjFlow& flow : item.second)
+        {
+            out << "F " << item.first << " " << flow.src << " " << flow.kind << " " << flow.pts.count();
+            for (NodeID id : flow.pts)
+                out << " " << id;
+            for (NodeID id : flow.objs)
+                out << " " << id;
+            out << "\n";
+        }
+    }
+}
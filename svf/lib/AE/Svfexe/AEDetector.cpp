@@ -32,6 +32,32 @@
 #include "AE/Core/AddressValue.h"
 
 using namespace SVF;
+/**
+ * @brief Records the offsets of the GEP objects created at a given ICFG node.
+ *
+ * Runs while the node is interpreted, so that the offsets are in place for
+ * the SAFE_BUFACCESS/UNSAFE_BUFACCESS stubs and for GEPs on GEP objects
+ * further down the function. detect() only reads them.
+ *
+ * @param node Pointer to the ICFG node.
+ */
+void BufOverflowDetector::collectNodeFacts(const ICFGNode* node)
+{
+    if (SVFUtil::isa<CallICFGNode>(node))
+        return;
+    auto& ae = AbstractInterpretation::getAEInstance();
+    for (const SVFStmt* stmt : node->getSVFStmts())
+    {
+        if (const GepStmt* gep = SVFUtil::dyn_cast<GepStmt>(stmt))
+        {
+            const AbstractValue& lhsVal = ae.getAbsValue(gep->getLHSVar(), node);
+            const AbstractValue& rhsVal = ae.getAbsValue(gep->getRHSVar(), node);
+            updateGepObjOffsetFromBase(node, lhsVal.getAddrs(), rhsVal.getAddrs(),
+                                       ae.getGepByteOffset(gep));
+        }
+    }
+}
+
 /**
  * @brief Detects buffer overflow issues within a given ICFG node.
  *
@@ -39,7 +65,6 @@ using namespace SVF;
  * instructions for potential buffer overflows, and call nodes, where it checks
  * for external API calls that may cause overflows.
  *
- * @param as Reference to the abstract state.
  * @param node Pointer to the ICFG node.
  */
 void BufOverflowDetector::detect(const ICFGNode* node)
@@ -54,12 +79,7 @@ void BufOverflowDetector::detect(const ICFGNode* node)
             {
                 SVFIR* svfir = PAG::getPAG();
 
-                // Update the GEP object offset from its base
-                const AbstractValue& lhsVal = ae.getAbsValue(gep->getLHSVar(), node);
                 const AbstractValue& rhsVal = ae.getAbsValue(gep->getRHSVar(), node);
-                updateGepObjOffsetFromBase(node, lhsVal.getAddrs(), rhsVal.getAddrs(),
-                                           ae.getGepByteOffset(gep));
-
                 const AddressValue& objAddrs = rhsVal.getAddrs();
                 for (const auto& addr : objAddrs)
                 {
@@ -462,12 +482,11 @@ bool BufOverflowDetector::canSafelyAccessMemory(const SVF::ValVar* value, const
     SVFIR* svfir = PAG::getPAG();
     auto& ae = AbstractInterpretation::getAEInstance();
 
+    // A pointer without addresses is checked as the black hole; the state
+    // itself is left alone, as detectors may run after its successors
     AbstractValue ptrVal = ae.getAbsValue(value, node);
     if (!ptrVal.isAddr())
-    {
         ptrVal = AddressValue(BlackHoleObjAddr);
-        ae.updateAbsValue(value, ptrVal, node);
-    }
     for (const auto& addr : ptrVal.getAddrs())
     {
         NodeID objId = ae.getAbsState(node).getIDFromAddr(addr);
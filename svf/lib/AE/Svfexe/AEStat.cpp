@@ -36,14 +36,20 @@ void AEStat::countStateSize()
         generalNumMap["ES_Loc_AVG_Num"] = 0;
         generalNumMap["ES_Var_Addr_AVG_Num"] = 0;
         generalNumMap["ES_Loc_Addr_AVG_Num"] = 0;
+        generalNumMap["Trace_Peak_State_Num"] = 0;
     }
     ++count;
+    // the trace only grows between releases, so sampling per node finds the peak
+    u32_t& peak = generalNumMap["Trace_Peak_State_Num"];
+    peak = std::max<u32_t>(peak, _ae->abstractTrace.size());
 }
 
 
 void AEStat::finializeStat()
 {
     memUsage = getMemUsage();
+    peakMemUsage = getPeakMemUsage();
+    generalNumMap["Trace_Live_State_Num"] = _ae->abstractTrace.size();
     if (count > 0)
     {
         generalNumMap["ES_Var_AVG_Num"] /= count;
@@ -157,6 +163,7 @@ void AEStat::performStat()
         SVFUtil::outs() << std::setw(field_width) << it->first << it->second << "\n";
     }
     SVFUtil::outs() << "Memory usage: " << memUsage << "\n";
+    SVFUtil::outs() << "Peak memory usage: " << peakMemUsage << "\n";
 
     SVFUtil::outs() << "#######################################################" << std::endl;
     SVFUtil::outs().flush();
@@ -31,6 +31,9 @@
 #include "AE/Svfexe/AbstractInterpretation.h"
 #include "Util/Options.h"
 #include "Util/WorkList.h"
+#include <atomic>
+#include <fstream>
+#include <thread>
 
 using namespace SVF;
 
@@ -52,6 +55,7 @@ void AEWTO::initWTO()
 {
     callGraphSCC->find();
 
+    std::vector<ICFGWTO*> wtos;
     for (auto it = callGraph->begin(); it != callGraph->end(); it++)
     {
         const FunObjVar *fun = it->second->getFunction();
@@ -79,11 +83,109 @@ void AEWTO::initWTO()
                 funcScc.insert(callGraph->getGNode(node)->getFunction());
             }
             ICFGWTO* iwto = new ICFGWTO(icfg->getFunEntryICFGNode(fun), funcScc);
-            iwto->init();
+            wtos.push_back(iwto);
             funcToWTO[it->second->getFunction()] = iwto;
         }
     }
 
+    // Orders read back from the cache need not be computed again
+    std::vector<ICFGWTO*> pending;
+    bool cacheHit = !Options::WTOCache().empty() && readWTOCache(Options::WTOCache(), wtos, pending);
+    if (!cacheHit)
+        pending = wtos;
+
+    // The orders of different SCCs only read the ICFG, so they are built independently
+    std::atomic<u32_t> next(0);
+    auto worker = [&]()
+    {
+        for (u32_t i = next++; i < pending.size(); i = next++)
+            pending[i]->init();
+    };
+    u32_t numThreads = std::min<u32_t>(std::max<u32_t>(Options::WTOThreads(), 1), pending.size());
+    if (numThreads <= 1)
+        worker();
+    else
+    {
+        std::vector<std::thread> threads;
+        for (u32_t t = 0; t < numThreads; ++t)
+            threads.push_back(std::thread(worker));
+        for (std::thread& t : threads)
+            t.join();
+    }
+
+    if (!Options::WTOCache().empty() && !pending.empty())
+        writeWTOCache(Options::WTOCache(), wtos);
+}
+
+/*!
+ * WTO cache format:
+ *   SVF-WTO-CACHE <#ICFG nodes> <#ICFG edges> <ICFG structure hash>
+ *   <entry ICFG node id> <components written by WTO::write>
+ *   ...
+ * The ICFG hash in the header guards against reusing a cache of another program
+ * or of an earlier build of the same one.
+ */
+bool AEWTO::readWTOCache(const std::string& fileName, const std::vector<ICFGWTO*>& wtos,
+                         std::vector<ICFGWTO*>& pending)
+{
+    std::ifstream in(fileName);
+    if (!in.is_open())
+        return false;
+
+    std::string line;
+    if (!std::getline(in, line) || line != getWTOCacheHeader())
+        return false;
+
+    Map<NodeID, std::string> entryToOrder;
+    while (std::getline(in, line))
+    {
+        std::istringstream ss(line);
+        NodeID entry;
+        if (ss >> entry)
+            entryToOrder[entry] = line;
+    }
+
+    auto getNode = [this](NodeID id) -> const ICFGNode*
+    {
+        return icfg->hasGNode(id) ? icfg->getGNode(id) : nullptr;
+    };
+    for (ICFGWTO* wto : wtos)
+    {
+        auto it = entryToOrder.find(wto->getEntry()->getId());
+        if (it == entryToOrder.end())
+        {
+            pending.push_back(wto);
+            continue;
+        }
+        std::istringstream ss(it->second);
+        NodeID entry;
+        ss >> entry;
+        if (!wto->read(ss, getNode))
+            pending.push_back(wto);
+    }
+    return true;
+}
+
+void AEWTO::writeWTOCache(const std::string& fileName, const std::vector<ICFGWTO*>& wtos) const
+{
+    std::ofstream out(fileName);
+    if (!out.is_open())
+    {
+        SVFUtil::errs() << "Unable to write WTO cache " << fileName << "\n";
+        return;
+    }
+    out << getWTOCacheHeader() << "\n";
+    for (const ICFGWTO* wto : wtos)
+    {
+        out << wto->getEntry()->getId() << " ";
+        wto->write(out);
+    }
+}
+
+std::string AEWTO::getWTOCacheHeader() const
+{
+    return "SVF-WTO-CACHE " + std::to_string(icfg->getTotalNodeNum()) + " " +
+           std::to_string(icfg->getTotalEdgeNum()) + " " + std::to_string(icfg->getStructureHash());
 }
 
 // ---------------------------------------------------------------------------
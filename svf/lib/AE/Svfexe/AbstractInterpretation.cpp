@@ -358,6 +358,33 @@ static const LoadStmt* findBackingLoad(const SVFVar* var)
     return nullptr;
 }
 
+/// Collect the ICFG nodes of the loads whose ObjVars collectBranchRefinement
+/// narrows for a conditional edge: the backing loads of a cmp's operands, or
+/// the loads defining a switch condition.
+static void collectBranchLoadNodes(const IntraCFGEdge* edge,
+                                   Set<const ICFGNode*>& loadNodes)
+{
+    const SVFVar* cond = edge->getCondition();
+    if (cond->getInEdges().empty())
+        return;
+    if (const CmpStmt* cmpStmt = SVFUtil::dyn_cast<CmpStmt>(*cond->getInEdges().begin()))
+    {
+        for (u32_t i = 0; i < 2; i++)
+        {
+            if (const LoadStmt* load = findBackingLoad(cmpStmt->getOpVar(i)))
+                loadNodes.insert(load->getICFGNode());
+        }
+    }
+    else
+    {
+        for (const SVFStmt* stmt : cond->getInEdges())
+        {
+            if (const LoadStmt* load = SVFUtil::dyn_cast<LoadStmt>(stmt))
+                loadNodes.insert(load->getICFGNode());
+        }
+    }
+}
+
 /// Compute the interval constraint on one cmp operand given the predicate,
 /// branch direction (succ), which side it is on, and the other operand's
 /// interval. Returns top if no useful narrowing is possible.
@@ -759,9 +786,20 @@ bool AbstractInterpretation::handleICFGNode(const ICFGNode* node)
         handleCallSite(callNode);
     }
 
-    // Run detectors
+    // Detectors record what they need now and check the node once its
+    // component has stabilized
     for (auto& detector: detectors)
-        detector->detect(node);
+        detector->collectNodeFacts(node);
+    if (!detectors.empty())
+    {
+        if (detectBatches.empty())
+        {
+            for (auto& detector: detectors)
+                detector->detect(node);
+        }
+        else if (detectBatches.back().visited.insert(node).second)
+            detectBatches.back().nodes.push_back(node);
+    }
     stat->countStateSize();
 
     // Track this node as analyzed (for coverage statistics across all entry points)
@@ -787,6 +825,11 @@ void AbstractInterpretation::handleFunction(const ICFGNode* funEntry, const Call
     // Push all top-level WTO components into the worklist in WTO order
     FIFOWorkList<const ICFGWTOComp*> worklist(it->second->getWTOComponents());
 
+    const TraceReleasePlan* releasePlan =
+        Options::AEReleaseTrace() ? &getTraceReleasePlan(it->first, it->second) : nullptr;
+    u32_t compIdx = 0;
+    detectBatches.emplace_back();
+
     while (!worklist.empty())
     {
         const ICFGWTOComp* comp = worklist.pop();
@@ -802,7 +845,116 @@ void AbstractInterpretation::handleFunction(const ICFGNode* funEntry, const Call
             if (mergeStatesFromPredecessors(cycle->head()->getICFGNode()))
                 handleLoopOrRecursion(cycle, caller);
         }
+
+        // The component has stabilized: check it, then drop the states no
+        // later one reads.
+        runDetectors();
+        // Recursive call sites are skipped, so the function is never
+        // re-entered while this loop still needs its earlier states.
+        if (releasePlan)
+        {
+            for (const ICFGNode* node : (*releasePlan)[compIdx])
+            {
+                if (releaseAbsState(node))
+                    stat->getTraceReleaseNum()++;
+            }
+        }
+        compIdx++;
+    }
+    detectBatches.pop_back();
+}
+
+void AbstractInterpretation::runDetectors()
+{
+    DetectBatch& batch = detectBatches.back();
+    for (auto& detector: detectors)
+    {
+        for (const ICFGNode* node : batch.nodes)
+            detector->detect(node);
+    }
+    batch.nodes.clear();
+    batch.visited.clear();
+}
+
+const AbstractInterpretation::TraceReleasePlan& AbstractInterpretation::getTraceReleasePlan(
+    const FunObjVar* fun, const ICFGWTO* wto)
+{
+    auto planIt = traceReleasePlans.find(fun);
+    if (planIt != traceReleasePlans.end())
+        return planIt->second;
+
+    // Index every node, nested cycles included, by its top-level component
+    Map<const ICFGNode*, u32_t> compOf;
+    Set<const ICFGNode*> heads;
+    u32_t compIdx = 0;
+    for (const ICFGWTOComp* topComp : wto->getWTOComponents())
+    {
+        std::vector<const ICFGWTOComp*> comps {topComp};
+        while (!comps.empty())
+        {
+            const ICFGWTOComp* comp = comps.back();
+            comps.pop_back();
+            if (const ICFGSingletonWTO* singleton = SVFUtil::dyn_cast<ICFGSingletonWTO>(comp))
+            {
+                compOf[singleton->getICFGNode()] = compIdx;
+            }
+            else if (const ICFGCycleWTO* cycle = SVFUtil::dyn_cast<ICFGCycleWTO>(comp))
+            {
+                compOf[cycle->head()->getICFGNode()] = compIdx;
+                heads.insert(cycle->head()->getICFGNode());
+                comps.insert(comps.end(), cycle->getWTOComponents().begin(),
+                             cycle->getWTOComponents().end());
+            }
+        }
+        compIdx++;
+    }
+
+    Map<const ICFGNode*, u32_t> lastUse(compOf);
+    auto extendUse = [&lastUse](const ICFGNode* node, u32_t use)
+    {
+        auto useIt = lastUse.find(node);
+        if (useIt != lastUse.end())
+            useIt->second = std::max(useIt->second, use);
+    };
+
+    Set<const ICFGNode*> kept(heads);
+    for (const auto& [node, pos] : compOf)
+    {
+        // Read across functions (call/ret edges, callee entry, caller ret-site)
+        if (SVFUtil::isa<FunEntryICFGNode, FunExitICFGNode, CallICFGNode, RetICFGNode>(node))
+            kept.insert(node);
+
+        for (const ICFGEdge* edge : node->getOutEdges())
+        {
+            const IntraCFGEdge* intraEdge = SVFUtil::dyn_cast<IntraCFGEdge>(edge);
+            if (!intraEdge)
+                continue;
+            auto dstIt = compOf.find(intraEdge->getDstNode());
+            if (dstIt == compOf.end())
+                continue;
+            // A cycle head joins its back-edge sources again when the
+            // function is analysed from another call site
+            if (heads.count(dstIt->first))
+                kept.insert(node);
+            extendUse(node, dstIt->second);
+            if (intraEdge->getCondition())
+            {
+                Set<const ICFGNode*> loadNodes;
+                collectBranchLoadNodes(intraEdge, loadNodes);
+                for (const ICFGNode* loadNode : loadNodes)
+                    extendUse(loadNode, dstIt->second);
+            }
+        }
+    }
+
+    TraceReleasePlan& plan = traceReleasePlans[fun];
+    plan.resize(compIdx);
+    for (const auto& [node, use] : lastUse)
+    {
+        if (!kept.count(node))
+            plan[use].push_back(node);
     }
+    return plan;
 }
 
 
@@ -66,6 +66,11 @@ bool AbstractInterpretation::hasAbsState(const ICFGNode* node)
     return abstractTrace.count(node) != 0;
 }
 
+bool AbstractInterpretation::releaseAbsState(const ICFGNode* node)
+{
+    return abstractTrace.erase(node) != 0;
+}
+
 /// Dense base: direct trace lookup, with a top sentinel for genuinely
 /// missing entries (e.g. function parameters like argc, never written
 /// before first read).  Sparse subclasses override with a def-site
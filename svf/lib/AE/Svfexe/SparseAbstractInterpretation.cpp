@@ -26,6 +26,7 @@
 #include "Graphs/SVFG.h"
 #include "MSSA/SVFGBuilder.h"
 #include "WPA/Andersen.h"
+#include "Util/Options.h"
 
 using namespace SVF;
 
@@ -41,10 +42,19 @@ using namespace SVF;
 
 FullSparseAbstractInterpretation::~FullSparseAbstractInterpretation() = default;
 
-void FullSparseAbstractInterpretation::buildSVFG()
+void FullSparseAbstractInterpretation::buildObjFlowIndex()
 {
-    svfgBuilder = std::make_unique<SVFGBuilder>(true);
-    svfg = svfgBuilder->buildFullSVFG(preAnalysis->getPointerAnalysis());
+    const std::string& indexFile = Options::AEDefUseIndex();
+    AndersenWaveDiff* pta = preAnalysis->getPointerAnalysis();
+    // An index written by an earlier run on the same SVFIR makes the SVFG unnecessary
+    if (!indexFile.empty() && defUseIndex->read(indexFile, pta))
+        return;
+
+    // The SVFG is only needed to build the index and is released with the builder
+    SVFGBuilder svfgBuilder(true);
+    defUseIndex->buildObjFlows(svfgBuilder.buildFullSVFG(pta));
+    if (!indexFile.empty())
+        defUseIndex->write(indexFile, pta);
 }
 
 // =====================================================================
@@ -138,12 +148,13 @@ void FullSparseAbstractInterpretation::pullObjValueFlows(const ICFGNode* node)
     //     store i32 7, i32* %p   ; def-site D for obj_p
     //     ...
     //     %v = load i32, i32* %p ; use-site U
-    // Step 1: intra-node SVFG-pull.  For each VFG node hosted at U, walk
-    // the indirect SVFG in-edges back to D; for every obj id labelling
-    // the edge, JOIN the obj's value at D into U's trace.  GepObjVar
-    // labels are pulled exactly.  BaseObjVar labels are expanded to every
-    // sibling field via getAllFieldsObjVars because Andersen may label a
-    // field-sensitive consumer with the field-insensitive base.
+    // Step 1: intra-node SVFG-pull.  For each indirect SVFG flow into U
+    // recorded in the def-use index, go back to D; for every obj id
+    // labelling the edge, JOIN the obj's value at D into U's trace.
+    // GepObjVar labels are pulled exactly.  BaseObjVar labels were
+    // expanded to every sibling field when the index was built, because
+    // Andersen may label a field-sensitive consumer with the
+    // field-insensitive base.
     //
     // Gep fields already present at this node came through the dense
     // ICFG propagation in joinStates.  Treat those as authoritative and
@@ -153,78 +164,32 @@ void FullSparseAbstractInterpretation::pullObjValueFlows(const ICFGNode* node)
     // Reads/writes go through SemiSparse to bypass FullSparse's refinement
     // layer (these are def-site pulls, not real stores; refinement is
     // applied later in propagateAndApplyRefinement).
-    for (const VFGNode* v : node->getVFGNodes())
+    for (const AEDefUseIndex::ObjFlow& flow : defUseIndex->getObjFlows(node))
     {
-        for (auto eit = v->InEdgeBegin(); eit != v->InEdgeEnd(); ++eit)
+        const ICFGNode* srcICFG = svfir->getICFG()->getICFGNode(flow.src);
+        if (!isObjFlowFeasible(flow, srcICFG, node) || !hasAbsState(srcICFG))
+            continue;
+
+        for (NodeID fid : flow.objs)
         {
-            const IndirectSVFGEdge* indEdge =
-                SVFUtil::dyn_cast<IndirectSVFGEdge>(*eit);
-            if (indEdge)
+            const ObjVar* obj = SVFUtil::dyn_cast<ObjVar>(svfir->getGNode(fid));
+            // Dense Gep propagation has already carried the
+            // current value to this node.
+            if (denseLocalObjs.test(fid))
             {
-                const SVFGNode* src =
-                    SVFUtil::dyn_cast<SVFGNode>(indEdge->getSrcNode());
-                assert(src && "SVFG incoming edge must have a source node");
-                assert(v && "SVFG incoming edge must have a destination node");
-
-                const ICFGNode* srcICFG = src->getICFGNode();
-                const ICFGNode* dstICFG = v->getICFGNode();
-                (void)dstICFG; // Suppress warning of unused variable under release build
-                assert(srcICFG && "SVFG source node must have an ICFG node");
-                assert(dstICFG &&
-                       "SVFG destination node must have an ICFG node");
-
-                if (!isIndirectSVFGEdgeFeasible(indEdge, v))
-                    continue;
-
-                if (srcICFG && hasAbsState(srcICFG))
+                continue;
+            }
+            if (obj &&
+                    SemiSparseAbstractInterpretation::hasAbsValue(obj, srcICFG))
+            {
+                AbstractValue cur;
+                if (SemiSparseAbstractInterpretation::hasAbsValue(obj, node))
                 {
-                    for (NodeID id : indEdge->getPointsTo())
-                    {
-                        SVFVar* gn = svfir->getGNode(id);
-                        NodeBS idsToPull;
-
-                        if (SVFUtil::isa<GepObjVar>(gn))
-                        {
-                            idsToPull.set(id);
-                        }
-                        else if (auto* base = SVFUtil::dyn_cast<BaseObjVar>(gn))
-                        {
-                            idsToPull = svfir->getAllFieldsObjVars(base);
-                        }
-                        else
-                        {
-                            idsToPull.set(id);
-                        }
-
-                        for (NodeID fid : idsToPull)
-                        {
-                            const ObjVar* obj =
-                                SVFUtil::dyn_cast<ObjVar>(svfir->getGNode(fid));
-                            // Dense Gep propagation has already carried the
-                            // current value to this node.
-                            if (denseLocalObjs.test(fid))
-                            {
-                                continue;
-                            }
-                            if (obj &&
-                                    SemiSparseAbstractInterpretation::hasAbsValue(
-                                        obj, srcICFG))
-                            {
-                                AbstractValue cur;
-                                if (SemiSparseAbstractInterpretation::
-                                        hasAbsValue(obj, node))
-                                {
-                                    cur = SemiSparseAbstractInterpretation::
-                                          getAbsValue(obj, node);
-                                }
-                                cur.join_with(SemiSparseAbstractInterpretation::
-                                              getAbsValue(obj, srcICFG));
-                                SemiSparseAbstractInterpretation::
-                                updateAbsValue(obj, cur, node);
-                            }
-                        }
-                    }
+                    cur = SemiSparseAbstractInterpretation::getAbsValue(obj, node);
                 }
+                cur.join_with(SemiSparseAbstractInterpretation::
+                              getAbsValue(obj, srcICFG));
+                SemiSparseAbstractInterpretation::updateAbsValue(obj, cur, node);
             }
         }
     }
@@ -238,221 +203,105 @@ void FullSparseAbstractInterpretation::pullObjValueFlows(const ICFGNode* node)
 //  Full-sparse — refinement trace machinery.
 // =====================================================================
 
-static bool hasRedefineToSameObj(const ICFGNode* node,
-                                 const IndirectSVFGEdge* edge)
+bool FullSparseAbstractInterpretation::isObjFlowFeasible(
+    const AEDefUseIndex::ObjFlow& flow, const ICFGNode* src, const ICFGNode* dst)
 {
-    for (const VFGNode* vfgNode : node->getVFGNodes())
+    switch (flow.kind)
     {
-        if (SVFUtil::isa<StoreVFGNode>(vfgNode) &&
-                vfgNode->getDefSVFVars().intersects(edge->getPointsTo()))
-            return true;
+    case AEDefUseIndex::AlwaysFeasible:
+        return true;
+    case AEDefUseIndex::NeverFeasible:
+        return false;
+    default:
+        // Only paths through conditional edges exist; they depend on the
+        // branch state, which is not known until the analysis reaches them.
+        return searchFeasiblePath(src, dst, &flow.pts);
     }
-
-    return false;
 }
 
-bool FullSparseAbstractInterpretation::isIndirectSVFGEdgeFeasible(
-    const IndirectSVFGEdge* edge, const VFGNode* dst)
+bool FullSparseAbstractInterpretation::isICFGPathFeasible(const ICFGNode* src,
+        const ICFGNode* dst)
 {
-    assert(edge && "Indirect SVFG edge must exist");
-    assert(dst && "Indirect SVFG edge must have a destination node");
-
-    const SVFGNode* src = SVFUtil::dyn_cast<SVFGNode>(edge->getSrcNode());
-    assert(src && "Indirect SVFG edge must have an SVFG source node");
-
-    const ICFGNode* srcICFG = src->getICFGNode();
-    const ICFGNode* dstICFG = dst->getICFGNode();
-    assert(srcICFG && "SVFG source node must have an ICFG node");
-    assert(dstICFG && "SVFG destination node must have an ICFG node");
-
-    const FunObjVar* fun = srcICFG->getFun();
-    bool feasible = true;
-    if (srcICFG == dstICFG)
-    {
-        feasible = true;
-    }
-    else if (!fun || fun != dstICFG->getFun())
+    if (!src || !dst)
+        return true;
+    switch (defUseIndex->getPathKind(src, dst))
     {
-        feasible = true;
+    case AEDefUseIndex::AlwaysFeasible:
+        return true;
+    case AEDefUseIndex::NeverFeasible:
+        return false;
+    default:
+        return searchFeasiblePath(src, dst, nullptr);
     }
-    else
+}
+
+bool FullSparseAbstractInterpretation::searchFeasiblePath(const ICFGNode* src,
+        const ICFGNode* dst, const NodeBS* killPts)
+{
+    const FunObjVar* fun = src->getFun();
+    bool feasible = false;
+    std::deque<const ICFGNode*> worklist;
+    Set<const ICFGNode*> visited;
+    worklist.push_back(src);
+    visited.insert(src);
+
+    while (!worklist.empty() && !feasible)
     {
-        feasible = false;
-        std::deque<const ICFGNode*> worklist;
-        Set<const ICFGNode*> visited;
-        worklist.push_back(srcICFG);
-        visited.insert(srcICFG);
+        const ICFGNode* cur = worklist.front();
+        worklist.pop_front();
 
-        while (!worklist.empty() && !feasible)
+        if (killPts && cur != src &&
+                defUseIndex->getStoredObjs(cur).intersects(*killPts))
         {
-            const ICFGNode* cur = worklist.front();
-            worklist.pop_front();
+            // This ICFG path redefines the same object before dst.
+            continue;
+        }
 
-            if (cur != srcICFG && hasRedefineToSameObj(cur, edge))
+        // Treat a call as an intra-procedural summary edge for path
+        // queries. Feasibility of the callee body is handled by the
+        // normal analysis; here we only need caller-side reachability,
+        // e.g. entry -> ret-site.
+        if (const CallICFGNode* call = SVFUtil::dyn_cast<CallICFGNode>(cur))
+        {
+            const ICFGNode* succ = call->getRetICFGNode();
+            if (!succ || succ->getFun() != fun)
             {
-                // This ICFG path redefines the same object before dst.
+                // Ignore missing or cross-function return summaries.
             }
-            else
+            else if (succ == dst)
             {
-                // Treat a call as an intra-procedural summary edge for path
-                // queries. Feasibility of the callee body is handled by the
-                // normal analysis; here we only need caller-side reachability,
-                // e.g. entry -> ret-site.
-                if (const CallICFGNode* call =
-                            SVFUtil::dyn_cast<CallICFGNode>(cur))
-                {
-                    const ICFGNode* succ = call->getRetICFGNode();
-                    if (!succ || succ->getFun() != fun)
-                    {
-                        // Ignore missing or cross-function return summaries.
-                    }
-                    else if (succ == dstICFG)
-                    {
-                        feasible = true;
-                    }
-                    else if (!visited.count(succ))
-                    {
-                        visited.insert(succ);
-                        worklist.push_back(succ);
-                    }
-                    else
-                    {
-                        // Already visited.
-                    }
-                }
-
-                for (const ICFGEdge* icfgEdge : cur->getOutEdges())
-                {
-                    const IntraCFGEdge* intraEdge =
-                        SVFUtil::dyn_cast<IntraCFGEdge>(icfgEdge);
-                    const ICFGNode* succ =
-                        intraEdge ? intraEdge->getDstNode() : nullptr;
-
-                    if (!intraEdge)
-                    {
-                        // Non-intra ICFG edges are not part of this path query.
-                    }
-                    else if (!succ || succ->getFun() != fun)
-                    {
-                        // Keep the query inside src's function.
-                    }
-                    else if (!isIntraEdgeBranchFeasible(intraEdge, cur))
-                    {
-                        // The conditional edge is unreachable in cur's state.
-                    }
-                    else if (succ == dstICFG)
-                    {
-                        feasible = true;
-                    }
-                    else if (!visited.count(succ))
-                    {
-                        visited.insert(succ);
-                        worklist.push_back(succ);
-                    }
-                    else
-                    {
-                        // Already visited.
-                    }
-                }
+                feasible = true;
+            }
+            else if (visited.insert(succ).second)
+            {
+                worklist.push_back(succ);
             }
         }
-    }
-
-    return feasible;
-}
 
-bool FullSparseAbstractInterpretation::isICFGPathFeasible(const ICFGNode* src,
-        const ICFGNode* dst)
-{
-    bool feasible = true;
-    if (!src || !dst)
-    {
-        feasible = true;
-    }
-    else if (src == dst)
-    {
-        feasible = true;
-    }
-    else
-    {
-        const FunObjVar* fun = src->getFun();
-        if (!fun || fun != dst->getFun())
+        for (const ICFGEdge* edge : cur->getOutEdges())
         {
-            feasible = true;
-        }
-        else
-        {
-            feasible = false;
-            std::deque<const ICFGNode*> worklist;
-            Set<const ICFGNode*> visited;
-            worklist.push_back(src);
-            visited.insert(src);
+            const IntraCFGEdge* intraEdge = SVFUtil::dyn_cast<IntraCFGEdge>(edge);
+            const ICFGNode* succ = intraEdge ? intraEdge->getDstNode() : nullptr;
 
-            while (!worklist.empty() && !feasible)
+            if (!intraEdge)
             {
-                const ICFGNode* cur = worklist.front();
-                worklist.pop_front();
-
-                // Treat a call as an intra-procedural summary edge for path
-                // queries. Feasibility of the callee body is handled by the
-                // normal analysis; here we only need caller-side reachability,
-                // e.g. entry -> ret-site.
-                if (const CallICFGNode* call =
-                            SVFUtil::dyn_cast<CallICFGNode>(cur))
-                {
-                    const ICFGNode* succ = call->getRetICFGNode();
-                    if (!succ || succ->getFun() != fun)
-                    {
-                        // Ignore missing or cross-function return summaries.
-                    }
-                    else if (succ == dst)
-                    {
-                        feasible = true;
-                    }
-                    else if (!visited.count(succ))
-                    {
-                        visited.insert(succ);
-                        worklist.push_back(succ);
-                    }
-                    else
-                    {
-                        // Already visited.
-                    }
-                }
-
-                for (const ICFGEdge* edge : cur->getOutEdges())
-                {
-                    const IntraCFGEdge* intraEdge =
-                        SVFUtil::dyn_cast<IntraCFGEdge>(edge);
-                    const ICFGNode* succ =
-                        intraEdge ? intraEdge->getDstNode() : nullptr;
-
-                    if (!intraEdge)
-                    {
-                        // Non-intra ICFG edges are not part of this path query.
-                    }
-                    else if (!succ || succ->getFun() != fun)
-                    {
-                        // Keep the query inside src's function.
-                    }
-                    else if (!isIntraEdgeBranchFeasible(intraEdge, cur))
-                    {
-                        // The conditional edge is unreachable in cur's state.
-                    }
-                    else if (succ == dst)
-                    {
-                        feasible = true;
-                    }
-                    else if (!visited.count(succ))
-                    {
-                        visited.insert(succ);
-                        worklist.push_back(succ);
-                    }
-                    else
-                    {
-                        // Already visited.
-                    }
-                }
+                // Non-intra ICFG edges are not part of this path query.
+            }
+            else if (!succ || succ->getFun() != fun)
+            {
+                // Keep the query inside src's function.
+            }
+            else if (!isIntraEdgeBranchFeasible(intraEdge, cur))
+            {
+                // The conditional edge is unreachable in cur's state.
+            }
+            else if (succ == dst)
+            {
+                feasible = true;
+            }
+            else if (visited.insert(succ).second)
+            {
+                worklist.push_back(succ);
             }
         }
     }
@@ -481,6 +330,11 @@ bool FullSparseAbstractInterpretation::isIntraEdgeBranchFeasible(
     return feasible;
 }
 
+bool FullSparseAbstractInterpretation::releaseAbsState(const ICFGNode*)
+{
+    return false;
+}
+
 void FullSparseAbstractInterpretation::recordBranchRefinement(
     NodeID objId, const IntervalValue& narrowed, AbstractState&,
     const ICFGNode*, const ICFGNode* succ)
@@ -685,27 +539,20 @@ void SemiSparseAbstractInterpretation::joinStates(AbstractState& dst,
         dst.addToFreedAddrs(a);
 }
 
+bool SemiSparseAbstractInterpretation::releaseAbsState(const ICFGNode* node)
+{
+    auto it = abstractTrace.find(node);
+    if (it == abstractTrace.end() ||
+            (it->second.getLocToVal().empty() && it->second.getFreedAddrs().empty()))
+        return false;
+    it->second.updateAddrStateOnly(AbstractState());
+    return true;
+}
+
 const ICFGNode* SemiSparseAbstractInterpretation::getICFGNode(
     const ValVar* var) const
 {
-    // const ValVars are all defined in global node
-    if (!var->getICFGNode())
-    {
-        return svfir->getICFG()->getGlobalICFGNode();
-    }
-    // for return value of callsite, use the ret-site as def-site
-    else if (SVFUtil::isa<CallICFGNode>(var->getICFGNode()) &&
-             SVFUtil::isa<RetValPN>(var))
-    {
-        return SVFUtil::dyn_cast<CallICFGNode>(var->getICFGNode())
-               ->getRetICFGNode();
-    }
-    // for other ValVars, use their def-site as the node to query abstract
-    // value.
-    else
-    {
-        return var->getICFGNode();
-    }
+    return defUseIndex->getDefSite(var);
 }
 
 void SemiSparseAbstractInterpretation::updateAbsValue(const ValVar* var,
@@ -263,6 +263,11 @@ void DDAStat::performStat()
     PTNumStatMap["NumOfMustAA"] = _TotalNumOfMustAliases;
     PTNumStatMap["NumOfInfePath"] = _TotalNumOfInfeasiblePath;
     PTNumStatMap["NumOfStore"] = SVFIR::getPAG()->getPTASVFStmtSet(SVFStmt::Store).size();
+    if (getSVFG()->isOnDemand())
+    {
+        PTNumStatMap["MaterializedFun"] = getSVFG()->getMaterializedFuns().size();
+        PTNumStatMap["OnDemandFun"] = getSVFG()->getOnDemandFunNum();
+    }
     timeStatMap["MemoryUsageVmrss"] = _vmrssUsageAfter - _vmrssUsageBefore;
     timeStatMap["MemoryUsageVmsize"] = _vmsizeUsageAfter - _vmsizeUsageBefore;
 
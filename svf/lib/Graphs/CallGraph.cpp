@@ -29,6 +29,7 @@
  */
 
 #include "Graphs/CallGraph.h"
+#include "Graphs/SCC.h"
 #include "SVFIR/SVFIR.h"
 #include "Util/Options.h"
 #include "Util/SVFUtil.h"
@@ -119,7 +120,7 @@ bool CallGraphNode::isReachableFromProgEntry(Map<NodeID, bool> &reachableFromEnt
 
 
 /// Constructor
-CallGraph::CallGraph(CGEK k): kind(k)
+CallGraph::CallGraph(CGEK k): kind(k), reachIndexBuilt(false)
 {
     callGraphNodeNum = 0;
     numOfResolvedIndCallEdge = 0;
@@ -131,6 +132,7 @@ CallGraph::CallGraph(const CallGraph& other)
     callGraphNodeNum = other.getTotalNodeNum();
     numOfResolvedIndCallEdge = 0;
     kind = NormCallGraph;
+    reachIndexBuilt = false;
 
     /// copy call graph nodes
     for (const auto& item : other)
@@ -302,8 +304,6 @@ void CallGraph::verifyCallGraph()
     if (Options::DisableWarn())
         return;
 
-    Map<NodeID, bool> reachableFromEntry;
-    NodeBS visitedNodes;
     CallEdgeMap::const_iterator it = indirectCallMap.begin();
     CallEdgeMap::const_iterator eit = indirectCallMap.end();
     for (; it != eit; ++it)
@@ -313,8 +313,7 @@ void CallGraph::verifyCallGraph()
         {
             const CallICFGNode* cs = it->first;
             const FunObjVar* func = cs->getCaller();
-            if (getCallGraphNode(func)->
-                    isReachableFromProgEntry(reachableFromEntry, visitedNodes) == false)
+            if (isReachableFromProgEntry(func) == false)
                 writeWrnMsg(func->getName() + " has indirect call site but not reachable from main");
         }
     }
@@ -325,30 +324,124 @@ void CallGraph::verifyCallGraph()
  */
 bool CallGraph::isReachableBetweenFunctions(const FunObjVar* srcFn, const FunObjVar* dstFn) const
 {
-    CallGraphNode* dstNode = getCallGraphNode(dstFn);
+    ensureReachIndex();
 
-    std::stack<const CallGraphNode*> nodeStack;
-    NodeBS visitedNodes;
-    nodeStack.push(dstNode);
-    visitedNodes.set(dstNode->getId());
+    NodeID srcRep = reachRep.at(getCallGraphNode(srcFn)->getId());
+    NodeID dstRep = reachRep.at(getCallGraphNode(dstFn)->getId());
+    return srcRep == dstRep || reachClosure.at(srcRep).test(dstRep);
+}
+
+/*!
+ * Whether a function is reachable from a program entry function
+ */
+bool CallGraph::isReachableFromProgEntry(const FunObjVar* fun) const
+{
+    ensureReachIndex();
+
+    return entryReachableReps.test(reachRep.at(getCallGraphNode(fun)->getId()));
+}
+
+/*!
+ * Build the index on the first query after it was invalidated. Queries may run
+ * concurrently, so the build is done by one of them under reachIndexMutex.
+ */
+void CallGraph::ensureReachIndex() const
+{
+    if (reachIndexBuilt.load(std::memory_order_acquire))
+        return;
+    std::lock_guard<std::mutex> lock(reachIndexMutex);
+    if (!reachIndexBuilt.load(std::memory_order_relaxed))
+        buildReachIndex();
+}
+
+/*!
+ * Collapse SCCs and compute, for every representative, the set of representatives it reaches.
+ * Tarjan's algorithm completes SCCs callees-first, so each closure is the union of the
+ * (already computed) closures of its successors.
+ */
+void CallGraph::buildReachIndex() const
+{
+    reachRep.clear();
+    reachClosure.clear();
+    reachReverse.clear();
+    entryReachableReps.clear();
+
+    SCCDetection<CallGraph*> scc(const_cast<CallGraph*>(this));
+    scc.find();
 
-    while (nodeStack.empty() == false)
+    std::vector<NodeID> topoOrder;
+    SCCDetection<CallGraph*>::GNodeStack topoStack = scc.topoNodeStack();
+    while (!topoStack.empty())
     {
-        CallGraphNode* node = const_cast<CallGraphNode*>(nodeStack.top());
-        nodeStack.pop();
+        topoOrder.push_back(topoStack.top());
+        topoStack.pop();
+    }
 
-        if (node->getFunction() == srcFn)
-            return true;
+    for (const auto& item : *this)
+        reachRep[item.first] = scc.repNode(item.first);
 
-        for (CallGraphEdgeConstIter it = node->InEdgeBegin(), eit = node->InEdgeEnd(); it != eit; ++it)
+    for (std::vector<NodeID>::const_reverse_iterator it = topoOrder.rbegin(), eit = topoOrder.rend(); it != eit; ++it)
+    {
+        NodeID rep = *it;
+        NodeBS& closure = reachClosure[rep];
+        for (NodeID sub : scc.subNodes(rep))
         {
-            CallGraphEdge* edge = *it;
-            if (visitedNodes.test_and_set(edge->getSrcID()))
-                nodeStack.push(edge->getSrcNode());
+            const CallGraphNode* node = getCallGraphNode(sub);
+            for (CallGraphEdgeConstIter eit = node->OutEdgeBegin(), eeit = node->OutEdgeEnd(); eit != eeit; ++eit)
+            {
+                NodeID dstRep = reachRep[(*eit)->getDstID()];
+                if (dstRep == rep)
+                    continue;
+                closure.set(dstRep);
+                closure |= reachClosure[dstRep];
+            }
+        }
+        for (NodeID reached : closure)
+            reachReverse[reached].set(rep);
+    }
+
+    for (const auto& item : *this)
+    {
+        if (SVFUtil::isProgEntryFunction(item.second->getFunction()))
+        {
+            NodeID rep = reachRep[item.first];
+            entryReachableReps.set(rep);
+            entryReachableReps |= reachClosure[rep];
         }
     }
 
-    return false;
+    reachIndexBuilt.store(true, std::memory_order_release);
+}
+
+/*!
+ * Maintain the index for a new edge src --> dst. Edges that do not change reachability are ignored,
+ * edges closing a cycle merge SCCs and invalidate the index, any other edge makes src and the
+ * representatives reaching it (its reverse closure) also reach dst and its closure.
+ */
+void CallGraph::updateReachIndex(NodeID src, NodeID dst)
+{
+    NodeID srcRep = reachRep.at(src);
+    NodeID dstRep = reachRep.at(dst);
+    NodeBS& srcClosure = reachClosure[srcRep];
+    if (srcRep == dstRep || srcClosure.test(dstRep))
+        return;
+
+    if (reachClosure[dstRep].test(srcRep))
+    {
+        reachIndexBuilt = false;
+        return;
+    }
+
+    NodeBS added = reachClosure[dstRep];
+    added.set(dstRep);
+    NodeBS reaching = reachReverse[srcRep];
+    reaching.set(srcRep);
+    for (NodeID rep : reaching)
+        reachClosure[rep] |= added;
+    for (NodeID rep : added)
+        reachReverse[rep] |= reaching;
+    if (entryReachableReps.test(srcRep))
+        entryReachableReps |= added;
 }
 
 /*!
@@ -380,6 +473,7 @@ void CallGraph::addCallGraphNode(CallGraphNode* cgNode)
     addGNode(cgNode->getId(), cgNode);
     funToCallGraphNodeMap[cgNode->getFunction()] = cgNode;
     callGraphNodeNum++;
+    reachIndexBuilt = false;
 }
 
 const CallGraphNode* CallGraph::getCallGraphNode(const std::string& name) const
@@ -586,6 +586,62 @@ bool ConstraintGraph::moveOutEdgesToRepNode(ConstraintNode*node, ConstraintNode*
     return criticalGepInsideSCC;
 }
 
+/*!
+ * Move the edges of a node that has been merged without moving its edges.
+ * Its rep is already set, so the end nodes are taken from the edge itself
+ * instead of getConstraintNode(), which would return the rep.
+ */
+void ConstraintGraph::removeMergedNode(ConstraintNode* node)
+{
+    OrderedSet<ConstraintEdge*> edges(node->InEdgeBegin(), node->InEdgeEnd());
+    edges.insert(node->OutEdgeBegin(), node->OutEdgeEnd());
+
+    for (ConstraintEdge* edge : edges)
+    {
+        ConstraintNode* srcNode = edge->getSrcNode();
+        ConstraintNode* dstNode = edge->getDstNode();
+        NodeID src = sccRepNode(srcNode->getId());
+        NodeID dst = sccRepNode(dstNode->getId());
+        if (AddrCGEdge* addr = SVFUtil::dyn_cast<AddrCGEdge>(edge))
+        {
+            srcNode->removeOutgoingAddrEdge(addr);
+            dstNode->removeIncomingAddrEdge(addr);
+            AddrCGEdgeSet.erase(addr);
+        }
+        else if (LoadCGEdge* load = SVFUtil::dyn_cast<LoadCGEdge>(edge))
+        {
+            srcNode->removeOutgoingLoadEdge(load);
+            dstNode->removeIncomingLoadEdge(load);
+            LoadCGEdgeSet.erase(load);
+            addLoadCGEdge(src, dst);
+        }
+        else if (StoreCGEdge* store = SVFUtil::dyn_cast<StoreCGEdge>(edge))
+        {
+            srcNode->removeOutgoingStoreEdge(store);
+            dstNode->removeIncomingStoreEdge(store);
+            StoreCGEdgeSet.erase(store);
+            addStoreCGEdge(src, dst);
+        }
+        else
+        {
+            srcNode->removeOutgoingDirectEdge(edge);
+            dstNode->removeIncomingDirectEdge(edge);
+            directEdgeSet.erase(edge);
+            if (src != dst)
+            {
+                if (SVFUtil::isa<CopyCGEdge>(edge))
+                    addCopyCGEdge(src, dst);
+                else if (const NormalGepCGEdge* gep = SVFUtil::dyn_cast<NormalGepCGEdge>(edge))
+                    addNormalGepCGEdge(src, dst, gep->getAccessPath());
+                else
+                    addVariantGepCGEdge(src, dst);
+            }
+        }
+        delete edge;
+    }
+    removeConstraintNode(node);
+}
+
 
 /*!
  * Dump constraint graph
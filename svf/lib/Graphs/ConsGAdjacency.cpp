@@ -0,0 +1,278 @@
+//===- ConsGAdjacency.cpp -- Compact adjacency of a constraint graph----------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * ConsGAdjacency.cpp
+ */
+
+#include "Graphs/ConsGAdjacency.h"
+
+using namespace SVF;
+using namespace SVFUtil;
+
+/*!
+ * Copy the edges of every node of the constraint graph into vectors
+ */
+ConstraintAdjacency::ConstraintAdjacency(ConstraintGraph* g): consCG(g), mergeEpoch(0)
+{
+    for (ConstraintGraph::iterator it = consCG->begin(), eit = consCG->end(); it != eit; ++it)
+    {
+        const ConstraintNode* node = it->second;
+        NodeAdj& nodeAdj = adj(it->first);
+        for (ConstraintEdge* edge : node->getCopyOutEdges())
+        {
+            nodeAdj.copyOut.push_back(edge->getDstID());
+            nodeAdj.copyTargets.set(edge->getDstID());
+        }
+        nodeAdj.gepOut.assign(node->getGepOutEdges().begin(), node->getGepOutEdges().end());
+        nodeAdj.gepIn.assign(node->getGepInEdges().begin(), node->getGepInEdges().end());
+        nodeAdj.loadOut.assign(node->getLoadOutEdges().begin(), node->getLoadOutEdges().end());
+        nodeAdj.storeIn.assign(node->getStoreInEdges().begin(), node->getStoreInEdges().end());
+    }
+}
+
+/*!
+ * Map the entries of rep's vectors to reps, dropping self-loops and
+ * the load (store) edges whose dst (src) rep has been seen already
+ */
+ConstraintAdjacency::NodeAdj& ConstraintAdjacency::compact(NodeID rep)
+{
+    NodeAdj& nodeAdj = adj(rep);
+    if (nodeAdj.epoch == mergeEpoch)
+        return nodeAdj;
+    nodeAdj.epoch = mergeEpoch;
+
+    NodeBS seen;
+    NodeVector copyOut;
+    for (NodeID dst : nodeAdj.copyOut)
+    {
+        dst = consCG->sccRepNode(dst);
+        if (dst != rep && seen.test_and_set(dst))
+            copyOut.push_back(dst);
+    }
+    nodeAdj.copyOut.swap(copyOut);
+    nodeAdj.copyTargets = seen;
+
+    /// a gep self-loop of rep itself is kept, as moveEdgesToRepNode() only
+    /// removes the gep edges inside an SCC when their nodes are merged
+    EdgeVector edges;
+    for (ConstraintEdge* gep : nodeAdj.gepOut)
+    {
+        if (consCG->sccRepNode(gep->getDstID()) != rep || gep->getDstID() == rep)
+            edges.push_back(gep);
+    }
+    nodeAdj.gepOut.swap(edges);
+
+    seen.clear();
+    edges.clear();
+    for (ConstraintEdge* load : nodeAdj.loadOut)
+    {
+        if (seen.test_and_set(consCG->sccRepNode(load->getDstID())))
+            edges.push_back(load);
+    }
+    nodeAdj.loadOut.swap(edges);
+
+    seen.clear();
+    edges.clear();
+    for (ConstraintEdge* store : nodeAdj.storeIn)
+    {
+        if (seen.test_and_set(consCG->sccRepNode(store->getSrcID())))
+            edges.push_back(store);
+    }
+    nodeAdj.storeIn.swap(edges);
+
+    return nodeAdj;
+}
+
+const ConstraintAdjacency::NodeVector& ConstraintAdjacency::getCopyOutNodes(NodeID rep)
+{
+    return compact(rep).copyOut;
+}
+
+const ConstraintAdjacency::EdgeVector& ConstraintAdjacency::getGepOutEdges(NodeID rep)
+{
+    return compact(rep).gepOut;
+}
+
+const ConstraintAdjacency::EdgeVector& ConstraintAdjacency::getLoadOutEdges(NodeID rep)
+{
+    return compact(rep).loadOut;
+}
+
+const ConstraintAdjacency::EdgeVector& ConstraintAdjacency::getStoreInEdges(NodeID rep)
+{
+    return compact(rep).storeIn;
+}
+
+bool ConstraintAdjacency::addCopyEdge(NodeID srcRep, NodeID dstRep)
+{
+    if (srcRep == dstRep)
+        return false;
+    NodeAdj& srcAdj = adj(srcRep);
+    if (!srcAdj.copyTargets.test_and_set(dstRep))
+        return false;
+    srcAdj.copyOut.push_back(dstRep);
+    return true;
+}
+
+/*!
+ * The gep edges connecting sub with rep's SCC or with itself are the ones
+ * moveEdgesToRepNode() would delete; a non-zero offset among them makes rep
+ * a PWC node.
+ */
+bool ConstraintAdjacency::mergeNode(NodeID sub, NodeID rep)
+{
+    NodeAdj& subAdj = adj(sub);
+    NodeAdj& repAdj = adj(rep);
+
+    bool pwc = false;
+    for (ConstraintEdge* gep : subAdj.gepOut)
+    {
+        NodeID dst = consCG->sccRepNode(gep->getDstID());
+        if ((dst == rep || dst == sub) && !consCG->isZeroOffsettedGepCGEdge(gep))
+            pwc = true;
+    }
+    for (ConstraintEdge* gep : subAdj.gepIn)
+    {
+        NodeID src = consCG->sccRepNode(gep->getSrcID());
+        if ((src == rep || src == sub) && !consCG->isZeroOffsettedGepCGEdge(gep))
+            pwc = true;
+    }
+
+    repAdj.copyOut.insert(repAdj.copyOut.end(), subAdj.copyOut.begin(), subAdj.copyOut.end());
+    repAdj.copyTargets |= subAdj.copyTargets;
+    repAdj.gepOut.insert(repAdj.gepOut.end(), subAdj.gepOut.begin(), subAdj.gepOut.end());
+    repAdj.gepIn.insert(repAdj.gepIn.end(), subAdj.gepIn.begin(), subAdj.gepIn.end());
+    repAdj.loadOut.insert(repAdj.loadOut.end(), subAdj.loadOut.begin(), subAdj.loadOut.end());
+    repAdj.storeIn.insert(repAdj.storeIn.end(), subAdj.storeIn.begin(), subAdj.storeIn.end());
+    nodeToAdj.erase(sub);
+
+    mergeEpoch++;
+    return pwc;
+}
+
+/*!
+ * Iterative Tarjan over the reps of the constraint graph. Like SCCDetection,
+ * an SCC is pushed when it is completed, so the top of the stack comes first
+ * in topological order.
+ */
+NodeStack& ConstraintAdjacency::detectSCCs()
+{
+    topoOrder = NodeStack();
+    sccToSubs.clear();
+
+    struct Frame
+    {
+        NodeID node;
+        NodeVector succs;
+        u32_t next;
+    };
+
+    Map<NodeID, u32_t> dfsNum;
+    Map<NodeID, u32_t> lowLink;
+    NodeBS onStack;
+    NodeVector sccStack;
+    std::vector<Frame> frames;
+    u32_t index = 0;
+
+    auto visit = [&](NodeID id)
+    {
+        dfsNum[id] = lowLink[id] = ++index;
+        sccStack.push_back(id);
+        onStack.set(id);
+        Frame frame{id, getCopyOutNodes(id), 0};
+        for (const ConstraintEdge* gep : getGepOutEdges(id))
+            frame.succs.push_back(gep->getDstID());
+        frames.push_back(std::move(frame));
+    };
+
+    for (ConstraintGraph::iterator it = consCG->begin(), eit = consCG->end(); it != eit; ++it)
+    {
+        NodeID root = it->first;
+        if (consCG->sccRepNode(root) != root || dfsNum.count(root))
+            continue;
+
+        visit(root);
+        while (!frames.empty())
+        {
+            Frame& frame = frames.back();
+            NodeID node = frame.node;
+            if (frame.next < frame.succs.size())
+            {
+                NodeID succ = consCG->sccRepNode(frame.succs[frame.next++]);
+                if (!dfsNum.count(succ))
+                    visit(succ);
+                else if (onStack.test(succ))
+                    lowLink[node] = std::min(lowLink[node], dfsNum[succ]);
+                continue;
+            }
+
+            if (lowLink[node] == dfsNum[node])
+            {
+                NodeBS& subs = sccToSubs[node];
+                NodeID member;
+                do
+                {
+                    member = sccStack.back();
+                    sccStack.pop_back();
+                    onStack.reset(member);
+                    subs.set(member);
+                }
+                while (member != node);
+                topoOrder.push(node);
+            }
+            frames.pop_back();
+            if (!frames.empty())
+            {
+                NodeID parent = frames.back().node;
+                lowLink[parent] = std::min(lowLink[parent], lowLink[node]);
+            }
+        }
+    }
+    return topoOrder;
+}
+
+/*!
+ * Bring the constraint graph to the state it has when merges move edges.
+ * The copy edges are written back first, as removing the merged nodes
+ * deletes the edges the vectors point to.
+ */
+void ConstraintAdjacency::materialize()
+{
+    for (auto& it : nodeToAdj)
+    {
+        if (consCG->sccRepNode(it.first) != it.first)
+            continue;
+        for (NodeID dst : compact(it.first).copyOut)
+            consCG->addCopyCGEdge(it.first, dst);
+    }
+    nodeToAdj.clear();
+
+    std::vector<ConstraintNode*> merged;
+    for (ConstraintGraph::iterator it = consCG->begin(), eit = consCG->end(); it != eit; ++it)
+    {
+        if (consCG->sccRepNode(it->first) != it->first)
+            merged.push_back(it->second);
+    }
+    for (ConstraintNode* node : merged)
+        consCG->removeMergedNode(node);
+}
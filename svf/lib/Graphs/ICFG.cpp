@@ -404,6 +404,23 @@ ICFGEdge* ICFG::addRetEdge(ICFGNode* srcNode, ICFGNode* dstNode)
     }
 }
 
+/*!
+ * Every node (id, kind) and edge (src, dst, kind) is mixed on its own and the
+ * results are summed, so the hash does not depend on the iteration order
+ */
+u64_t ICFG::getStructureHash() const
+{
+    u64_t hash = 0;
+    for (const_iterator it = begin(), eit = end(); it != eit; ++it)
+    {
+        const ICFGNode* node = it->second;
+        hash += SVFUtil::mixHash(((u64_t)node->getId() << 8) | (u64_t)node->getNodeKind());
+        for (const ICFGEdge* edge : node->getOutEdges())
+            hash += SVFUtil::mixHash(SVFUtil::mixHash(((u64_t)edge->getSrcID() << 32) | edge->getDstID())
+                                     ^ (u64_t)edge->getEdgeKind());
+    }
+    return hash;
+}
 
 /*!
  * Dump ICFG
@@ -36,6 +36,8 @@
 #include "Util/Options.h"
 #include "MemoryModel/PointerAnalysisImpl.h"
 #include <fstream>
+#include <atomic>
+#include <thread>
 #include "Util/Options.h"
 
 using namespace SVF;
@@ -201,7 +203,8 @@ FormalOUTSVFGNode::FormalOUTSVFGNode(NodeID id, const MRVer* mrVer, const FunExi
 /*!
  * Constructor
  */
-SVFG::SVFG(std::unique_ptr<MemSSA> mssa, VFGK k): VFG(mssa->getPTA()->getCallGraph(),k),mssa(std::move(mssa)), pta(this->mssa->getPTA())
+SVFG::SVFG(std::unique_ptr<MemSSA> mssa, VFGK k): VFG(mssa->getPTA()->getCallGraph(),k),mssa(std::move(mssa)), pta(this->mssa->getPTA()),
+    onDemand(false), numOnDemandFuns(0)
 {
     stat = new SVFGStat(this);
 }
@@ -234,6 +237,11 @@ void SVFG::buildSVFG()
     {
         readFile(Options::ReadSVFG());
     }
+    else if (onDemand)
+    {
+        /// address-taken nodes and edges are added function by function in materializeFun
+        DBOUT(DGENERAL, outs() << pasMsg("\tDefer SVFG Addr-taken Nodes and Indirect Edges\n"));
+    }
     else
     {
         DBOUT(DGENERAL, outs() << pasMsg("\tCreate SVFG Addr-taken Node\n"));
@@ -324,82 +332,107 @@ void SVFG::addSVFGNodesForAddrTakenVars()
     }
 }
 
+namespace
+{
+/// An indirect edge found by a worker of SVFG::connectIndirectSVFGEdges, added to the graph afterwards
+struct IndirectEdgeDesc
+{
+    VFGEdge::VFGEdgeK kind;
+    NodeID src;
+    NodeID dst;
+    CallSiteID csId;
+    NodeBS cpts;
+};
+}
+
 /*
  * Connect def-use chains for indirect value-flow, (value-flow of address-taken variables)
+ *
+ * The edges of each function are computed by Options::SVFGEdgeThreads() workers
+ * into per-function buffers, which only read memory SSA and the graph. The buffers
+ * are then added to the graph in the order functions first appear in node ID order,
+ * so the resulting graph does not depend on the number of threads.
  */
 void SVFG::connectIndirectSVFGEdges()
 {
-
+    Map<const FunObjVar*, u32_t> funToGroup;
+    std::vector<std::vector<const SVFGNode*>> groups;
     for(iterator it = begin(), eit = end(); it!=eit; ++it)
     {
-        NodeID nodeId = it->first;
-        const SVFGNode* node = it->second;
+        auto res = funToGroup.emplace(it->second->getFun(), groups.size());
+        if (res.second)
+            groups.emplace_back();
+        groups[res.first->second].push_back(it->second);
+    }
+
+    std::vector<std::vector<IndirectEdgeDesc>> buffers(groups.size());
+    auto collectEdges = [this](const SVFGNode* node, std::vector<IndirectEdgeDesc>& edges)
+    {
+        NodeID nodeId = node->getId();
+        auto addIntraEdge = [&edges, nodeId](NodeID def, const MRVer* ver)
+        {
+            edges.push_back({SVFGEdge::IntraIndirectVF, def, nodeId, 0, ver->getMR()->getPointsTo()});
+        };
+        auto addInterEdge = [&edges](SVFGEdge::VFGEdgeK kind, const MRSVFGNode* src, const MRSVFGNode* dst, CallSiteID csId)
+        {
+            if (src->getPointsTo().intersects(dst->getPointsTo()))
+                edges.push_back({kind, src->getId(), dst->getId(), csId, src->getPointsTo() & dst->getPointsTo()});
+        };
+
         if(const LoadSVFGNode* loadNode = SVFUtil::dyn_cast<LoadSVFGNode>(node))
         {
-            MUSet& muSet = mssa->getMUSet(SVFUtil::cast<LoadStmt>(loadNode->getSVFStmt()));
-            for(MUSet::iterator it = muSet.begin(), eit = muSet.end(); it!=eit; ++it)
+            auto muIt = mssa->getLoadToMUSetMap().find(SVFUtil::cast<LoadStmt>(loadNode->getSVFStmt()));
+            if (muIt == mssa->getLoadToMUSetMap().end())
+                return;
+            for (const MU* mu : muIt->second)
             {
-                if(LOADMU* mu = SVFUtil::dyn_cast<LOADMU>(*it))
-                {
-                    NodeID def = getDef(mu->getMRVer());
-                    addIntraIndirectVFEdge(def,nodeId, mu->getMRVer()->getMR()->getPointsTo());
-                }
+                if (SVFUtil::isa<LOADMU>(mu))
+                    addIntraEdge(getDef(mu->getMRVer()), mu->getMRVer());
             }
         }
         else if(const StoreSVFGNode* storeNode = SVFUtil::dyn_cast<StoreSVFGNode>(node))
         {
-            CHISet& chiSet = mssa->getCHISet(SVFUtil::cast<StoreStmt>(storeNode->getSVFStmt()));
-            for(CHISet::iterator it = chiSet.begin(), eit = chiSet.end(); it!=eit; ++it)
+            auto chiIt = mssa->getStoreToChiSetMap().find(SVFUtil::cast<StoreStmt>(storeNode->getSVFStmt()));
+            if (chiIt == mssa->getStoreToChiSetMap().end())
+                return;
+            for (const CHI* chi : chiIt->second)
             {
-                if(STORECHI* chi = SVFUtil::dyn_cast<STORECHI>(*it))
-                {
-                    NodeID def = getDef(chi->getOpVer());
-                    addIntraIndirectVFEdge(def,nodeId, chi->getOpVer()->getMR()->getPointsTo());
-                }
+                if (SVFUtil::isa<STORECHI>(chi))
+                    addIntraEdge(getDef(chi->getOpVer()), chi->getOpVer());
             }
         }
         else if(const FormalINSVFGNode* formalIn = SVFUtil::dyn_cast<FormalINSVFGNode>(node))
         {
             CallGraphEdge::CallInstSet callInstSet;
             mssa->getPTA()->getCallGraph()->getDirCallSitesInvokingCallee(formalIn->getFun(),callInstSet);
-            for(CallGraphEdge::CallInstSet::iterator it = callInstSet.begin(), eit = callInstSet.end(); it!=eit; ++it)
+            for (const CallICFGNode* cs : callInstSet)
             {
-                const CallICFGNode* cs = *it;
-                if(!mssa->hasMU(cs))
+                auto aiIt = callSiteToActualINMap.find(cs);
+                if(!mssa->hasMU(cs) || aiIt == callSiteToActualINMap.end())
                     continue;
-                ActualINSVFGNodeSet& actualIns = getActualINSVFGNodes(cs);
-                for(ActualINSVFGNodeSet::iterator ait = actualIns.begin(), aeit = actualIns.end(); ait!=aeit; ++ait)
-                {
-                    const ActualINSVFGNode* actualIn = SVFUtil::cast<ActualINSVFGNode>(getSVFGNode(*ait));
-                    addInterIndirectVFCallEdge(actualIn,formalIn,getCallSiteID(cs, formalIn->getFun()));
-                }
+                CallSiteID csId = getCallSiteID(cs, formalIn->getFun());
+                for (NodeID actualIn : aiIt->second)
+                    addInterEdge(SVFGEdge::CallIndVF, SVFUtil::cast<ActualINSVFGNode>(getSVFGNode(actualIn)), formalIn, csId);
             }
         }
         else if(const FormalOUTSVFGNode* formalOut = SVFUtil::dyn_cast<FormalOUTSVFGNode>(node))
         {
             CallGraphEdge::CallInstSet callInstSet;
-            // const MemSSA::RETMU* retMu = formalOut->getRetMU();
             mssa->getPTA()->getCallGraph()->getDirCallSitesInvokingCallee(formalOut->getFun(),callInstSet);
-            for(CallGraphEdge::CallInstSet::iterator it = callInstSet.begin(), eit = callInstSet.end(); it!=eit; ++it)
+            for (const CallICFGNode* cs : callInstSet)
             {
-                const CallICFGNode* cs = *it;
-                if(!mssa->hasCHI(cs))
+                auto aoIt = callSiteToActualOUTMap.find(cs);
+                if(!mssa->hasCHI(cs) || aoIt == callSiteToActualOUTMap.end())
                     continue;
-                ActualOUTSVFGNodeSet& actualOuts = getActualOUTSVFGNodes(cs);
-                for(ActualOUTSVFGNodeSet::iterator ait = actualOuts.begin(), aeit = actualOuts.end(); ait!=aeit; ++ait)
-                {
-                    const ActualOUTSVFGNode* actualOut = SVFUtil::cast<ActualOUTSVFGNode>(getSVFGNode(*ait));
-                    addInterIndirectVFRetEdge(formalOut,actualOut,getCallSiteID(cs, formalOut->getFun()));
-                }
+                CallSiteID csId = getCallSiteID(cs, formalOut->getFun());
+                for (NodeID actualOut : aoIt->second)
+                    addInterEdge(SVFGEdge::RetIndVF, formalOut, SVFUtil::cast<ActualOUTSVFGNode>(getSVFGNode(actualOut)), csId);
             }
-            NodeID def = getDef(formalOut->getMRVer());
-            addIntraIndirectVFEdge(def,nodeId, formalOut->getMRVer()->getMR()->getPointsTo());
+            addIntraEdge(getDef(formalOut->getMRVer()), formalOut->getMRVer());
         }
         else if(const ActualINSVFGNode* actualIn = SVFUtil::dyn_cast<ActualINSVFGNode>(node))
         {
-            const MRVer* ver = actualIn->getMRVer();
-            NodeID def = getDef(ver);
-            addIntraIndirectVFEdge(def,nodeId, ver->getMR()->getPointsTo());
+            addIntraEdge(getDef(actualIn->getMRVer()), actualIn->getMRVer());
         }
         else if(SVFUtil::isa<ActualOUTSVFGNode>(node))
         {
@@ -409,14 +442,43 @@ void SVFG::connectIndirectSVFGEdges()
         {
             for (MemSSA::PHI::OPVers::const_iterator it = phiNode->opVerBegin(), eit = phiNode->opVerEnd();
                     it != eit; it++)
-            {
-                const MRVer* op = it->second;
-                NodeID def = getDef(op);
-                addIntraIndirectVFEdge(def,nodeId, op->getMR()->getPointsTo());
-            }
+                addIntraEdge(getDef(it->second), it->second);
+        }
+    };
+
+    std::atomic<u32_t> next(0);
+    auto worker = [&]()
+    {
+        for (u32_t g = next++; g < groups.size(); g = next++)
+        {
+            for (const SVFGNode* node : groups[g])
+                collectEdges(node, buffers[g]);
         }
+    };
+    u32_t numThreads = std::min<u32_t>(std::max<u32_t>(Options::SVFGEdgeThreads(), 1), groups.size());
+    if (numThreads <= 1)
+        worker();
+    else
+    {
+        std::vector<std::thread> threads;
+        for (u32_t t = 0; t < numThreads; ++t)
+            threads.push_back(std::thread(worker));
+        for (std::thread& t : threads)
+            t.join();
     }
 
+    for (const std::vector<IndirectEdgeDesc>& edges : buffers)
+    {
+        for (const IndirectEdgeDesc& edge : edges)
+        {
+            if (edge.kind == SVFGEdge::IntraIndirectVF)
+                addIntraIndirectVFEdge(edge.src, edge.dst, edge.cpts);
+            else if (edge.kind == SVFGEdge::CallIndVF)
+                addCallIndirectVFEdge(edge.src, edge.dst, edge.cpts, edge.csId);
+            else
+                addRetIndirectVFEdge(edge.src, edge.dst, edge.cpts, edge.csId);
+        }
+    }
 
     connectFromGlobalToProgEntry();
 }
@@ -457,6 +519,271 @@ void SVFG::connectFromGlobalToProgEntry()
     }
 }
 
+/*!
+ * Defer memory SSA and the address-taken part of the SVFG to materializeFun.
+ * Top-level nodes and direct edges are still built for the whole program.
+ */
+void SVFG::enableOnDemand()
+{
+    onDemand = true;
+    numOnDemandFuns = 0;
+    for (const auto& item : *pag->getCallGraph())
+    {
+        if (!isExtCall(item.second->getFunction()))
+            numOnDemandFuns++;
+    }
+}
+
+/*!
+ * Nodes whose edges may cross function boundaries need the other end materialized:
+ * formal-in/out are connected with their call sites, actual-in/out with their callees
+ * and global stores with the entry of main.
+ */
+void SVFG::materializeAround(const SVFGNode* node)
+{
+    if (!onDemand)
+        return;
+
+    const FunObjVar* fun = node->getFun();
+    if (fun == nullptr)
+    {
+        materializeFun(getProgEntryFunction());
+        return;
+    }
+    materializeFun(fun);
+
+    if (const FormalINSVFGNode* formalIn = SVFUtil::dyn_cast<FormalINSVFGNode>(node))
+        fun = formalIn->getFun();
+    else if (const FormalOUTSVFGNode* formalOut = SVFUtil::dyn_cast<FormalOUTSVFGNode>(node))
+        fun = formalOut->getFun();
+    else
+        fun = nullptr;
+    if (fun != nullptr)
+    {
+        CallGraphEdge::CallInstSet csSet;
+        getConnectedCallSites(fun, csSet);
+        for (const CallICFGNode* cs : csSet)
+            materializeFun(cs->getCaller());
+    }
+
+    const CallICFGNode* cs = nullptr;
+    if (const ActualINSVFGNode* actualIn = SVFUtil::dyn_cast<ActualINSVFGNode>(node))
+        cs = actualIn->getCallSite();
+    else if (const ActualOUTSVFGNode* actualOut = SVFUtil::dyn_cast<ActualOUTSVFGNode>(node))
+        cs = actualOut->getCallSite();
+    if (cs != nullptr)
+    {
+        CallGraph::FunctionSet callees;
+        getConnectedCallees(cs, callees);
+        for (const FunObjVar* callee : callees)
+            materializeFun(callee);
+    }
+}
+
+/*!
+ * Build memory SSA of fun, add its address-taken nodes and connect them with the
+ * functions materialized so far. Once -svfg-on-demand-max-funs functions are
+ * materialized the remaining ones are built eagerly.
+ */
+void SVFG::materializeFun(const FunObjVar* fun)
+{
+    if (!onDemand || fun == nullptr || isExtCall(fun) || !materializedFunSet.insert(fun).second)
+        return;
+    materializedFuns.push_back(fun);
+
+    mssa->buildMemSSA(*fun);
+    NodeBS newNodes;
+    addSVFGNodesForAddrTakenVars(fun, newNodes);
+    connectIndirectSVFGEdges(fun, newNodes);
+
+    if (materializedFuns.size() == Options::SVFGOnDemandMaxFuns())
+    {
+        for (const auto& item : *pag->getCallGraph())
+            materializeFun(item.second->getFunction());
+    }
+}
+
+/*
+ * Create SVFG nodes for address-taken variables of a function
+ */
+void SVFG::addSVFGNodesForAddrTakenVars(const FunObjVar* fun, NodeBS& newNodes)
+{
+    for (const SVFStmt* stmt : pag->getFunSVFStmts(SVFStmt::Store, fun))
+    {
+        const StoreStmt* store = SVFUtil::cast<StoreStmt>(stmt);
+        if (!hasStmtVFGNode(store))
+            continue;
+        const StmtSVFGNode* sNode = getStmtVFGNode(store);
+        for (const CHI* chi : mssa->getCHISet(store))
+            setDef(chi->getResVer(), sNode);
+    }
+
+    for (const auto& bbIt : *fun)
+    {
+        const SVFBasicBlock* bb = bbIt.second;
+        if (!mssa->hasPHISet(bb))
+            continue;
+        for (MemSSA::PHI* phi : mssa->getPHISet(bb))
+        {
+            NodeID id = totalVFGNode++;
+            addIntraMSSAPHISVFGNode(const_cast<ICFGNode*>(bb->front()), phi->opVerBegin(), phi->opVerEnd(), phi->getResVer(), id);
+            newNodes.set(id);
+        }
+    }
+    if (mssa->hasFuncEntryChi(fun))
+    {
+        for (const CHI* chi : mssa->getFuncEntryChiSet(fun))
+        {
+            NodeID id = totalVFGNode++;
+            addFormalINSVFGNode(pag->getICFG()->getFunEntryICFGNode(fun), chi->getResVer(), id);
+            newNodes.set(id);
+        }
+    }
+    if (mssa->hasReturnMu(fun))
+    {
+        for (const MU* mu : mssa->getReturnMuSet(fun))
+        {
+            NodeID id = totalVFGNode++;
+            addFormalOUTSVFGNode(pag->getICFG()->getFunExitICFGNode(fun), mu->getMRVer(), id);
+            newNodes.set(id);
+        }
+    }
+    for (const auto& bbIt : *fun)
+    {
+        for (const ICFGNode* icfgNode : bbIt.second->getICFGNodeList())
+        {
+            const CallICFGNode* cs = SVFUtil::dyn_cast<CallICFGNode>(icfgNode);
+            if (cs == nullptr)
+                continue;
+            if (mssa->hasMU(cs))
+            {
+                for (const MU* mu : mssa->getMUSet(cs))
+                {
+                    NodeID id = totalVFGNode++;
+                    addActualINSVFGNode(cs, mu->getMRVer(), id);
+                    newNodes.set(id);
+                }
+            }
+            if (mssa->hasCHI(cs))
+            {
+                for (const CHI* chi : mssa->getCHISet(cs))
+                {
+                    NodeID id = totalVFGNode++;
+                    addActualOUTSVFGNode(cs, chi->getResVer(), id);
+                    newNodes.set(id);
+                }
+            }
+        }
+    }
+}
+
+/*
+ * Connect indirect def-use chains of a function, and its call edges with materialized functions
+ */
+void SVFG::connectIndirectSVFGEdges(const FunObjVar* fun, const NodeBS& newNodes)
+{
+    for (const SVFStmt* stmt : pag->getFunSVFStmts(SVFStmt::Load, fun))
+    {
+        const LoadStmt* load = SVFUtil::cast<LoadStmt>(stmt);
+        if (!hasStmtVFGNode(load))
+            continue;
+        NodeID nodeId = getStmtVFGNode(load)->getId();
+        for (const MU* mu : mssa->getMUSet(load))
+        {
+            if (SVFUtil::isa<LOADMU>(mu))
+                addIntraIndirectVFEdge(getDef(mu->getMRVer()), nodeId, mu->getMRVer()->getMR()->getPointsTo());
+        }
+    }
+    for (const SVFStmt* stmt : pag->getFunSVFStmts(SVFStmt::Store, fun))
+    {
+        const StoreStmt* store = SVFUtil::cast<StoreStmt>(stmt);
+        if (!hasStmtVFGNode(store))
+            continue;
+        NodeID nodeId = getStmtVFGNode(store)->getId();
+        for (const CHI* chi : mssa->getCHISet(store))
+        {
+            if (SVFUtil::isa<STORECHI>(chi))
+                addIntraIndirectVFEdge(getDef(chi->getOpVer()), nodeId, chi->getOpVer()->getMR()->getPointsTo());
+        }
+    }
+    for (NodeID nodeId : newNodes)
+    {
+        const SVFGNode* node = getSVFGNode(nodeId);
+        if (const FormalOUTSVFGNode* formalOut = SVFUtil::dyn_cast<FormalOUTSVFGNode>(node))
+        {
+            const MRVer* ver = formalOut->getMRVer();
+            addIntraIndirectVFEdge(getDef(ver), nodeId, ver->getMR()->getPointsTo());
+        }
+        else if (const ActualINSVFGNode* actualIn = SVFUtil::dyn_cast<ActualINSVFGNode>(node))
+        {
+            const MRVer* ver = actualIn->getMRVer();
+            addIntraIndirectVFEdge(getDef(ver), nodeId, ver->getMR()->getPointsTo());
+        }
+        else if (const MSSAPHISVFGNode* phiNode = SVFUtil::dyn_cast<MSSAPHISVFGNode>(node))
+        {
+            for (MemSSA::PHI::OPVers::const_iterator it = phiNode->opVerBegin(), eit = phiNode->opVerEnd();
+                    it != eit; it++)
+                addIntraIndirectVFEdge(getDef(it->second), nodeId, it->second->getMR()->getPointsTo());
+        }
+    }
+
+    /// fun as the callee (including recursive calls), then as the caller
+    SVFGEdgeSetTy edges;
+    CallGraphEdge::CallInstSet csSet;
+    getConnectedCallSites(fun, csSet);
+    for (const CallICFGNode* cs : csSet)
+    {
+        if (isMaterialized(cs->getCaller()))
+            connectMSSACallerAndCallee(cs, fun, edges);
+    }
+    for (const auto& bbIt : *fun)
+    {
+        for (const ICFGNode* icfgNode : bbIt.second->getICFGNodeList())
+        {
+            const CallICFGNode* cs = SVFUtil::dyn_cast<CallICFGNode>(icfgNode);
+            if (cs == nullptr)
+                continue;
+            CallGraph::FunctionSet callees;
+            getConnectedCallees(cs, callees);
+            for (const FunObjVar* callee : callees)
+            {
+                if (callee != fun && isMaterialized(callee))
+                    connectMSSACallerAndCallee(cs, callee, edges);
+            }
+        }
+    }
+
+    if (fun == getProgEntryFunction())
+        connectFromGlobalToProgEntry();
+}
+
+/*!
+ * Direct call sites on the call graph, plus indirect ones connected via connectCallerAndCallee
+ */
+void SVFG::getConnectedCallSites(const FunObjVar* fun, CallGraphEdge::CallInstSet& csSet) const
+{
+    callgraph->getDirCallSitesInvokingCallee(fun, csSet);
+    auto it = indCallSitesOfFun.find(fun);
+    if (it != indCallSitesOfFun.end())
+        csSet.insert(it->second.begin(), it->second.end());
+}
+
+void SVFG::getConnectedCallees(const CallICFGNode* cs, CallGraph::FunctionSet& callees) const
+{
+    if (callgraph->hasCallGraphEdge(cs))
+    {
+        for (CallGraph::CallGraphEdgeSet::const_iterator it = callgraph->getCallEdgeBegin(cs),
+                eit = callgraph->getCallEdgeEnd(cs); it != eit; ++it)
+        {
+            if ((*it)->isDirectCallEdge())
+                callees.insert((*it)->getDstNode()->getFunction());
+        }
+    }
+    auto it = indCalleesOfCallSite.find(cs);
+    if (it != indCalleesOfCallSite.end())
+        callees.insert(it->second.begin(), it->second.end());
+}
+
 /*
  *  Add def-use edges of a memory region between two statements
  */
@@ -659,6 +986,22 @@ void SVFG::connectCallerAndCallee(const CallICFGNode* cs, const FunObjVar* calle
 {
     VFG::connectCallerAndCallee(cs,callee,edges);
 
+    if (onDemand)
+    {
+        /// connected by materializeFun unless both ends are already materialized
+        indCallSitesOfFun[callee].insert(cs);
+        indCalleesOfCallSite[cs].insert(callee);
+        if (!isMaterialized(cs->getCaller()) || !isMaterialized(callee))
+            return;
+    }
+    connectMSSACallerAndCallee(cs, callee, edges);
+}
+
+/*!
+ * Connect actual-in/out of a call site with formal-in/out of its callee
+ */
+void SVFG::connectMSSACallerAndCallee(const CallICFGNode* cs, const FunObjVar* callee, SVFGEdgeSetTy& edges)
+{
     CallSiteID csId = getCallSiteID(cs, callee);
 
     // connect actual in and formal in
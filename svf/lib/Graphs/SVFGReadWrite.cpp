@@ -32,12 +32,112 @@
 #include "Graphs/SVFGStat.h"
 #include "MemoryModel/PointerAnalysisImpl.h"
 #include <fstream>
+#include <limits>
 #include "Util/Options.h"
 
 using namespace SVF;
 using namespace SVFUtil;
 using namespace std;
 
+namespace
+{
+
+// Format of the binary file (-svfg-binary); all integers are LEB128 varints
+// unless noted otherwise
+// <magic: 8 bytes> <format version>
+// __MemRegions__  <num> { <pts size> <pts delta-encoded ascending> }*
+// __MRVers__      <num> { <region index> <SSA version> <MSSADef type> }*
+// __Nodes__       <num> { <node kind> <SVFGNodeID> <MRVer index> <ICFGNodeID> [<num ops> { <op pos> <MRVer index> }*] }*
+// __Edges__       { <edge kind> <src SVFGNodeID> <dst SVFGNodeID> [<region index>] }* <EdgeEnd>
+// Points-to sets are only stored once in the region table and referenced by
+// index from MRVers and intra edges, so the file size is dominated by the
+// node and edge records, which are read one at a time.
+const char SVFGBinaryMagic[8] = {'S', 'V', 'F', 'G', 'B', 'I', 'N', '\0'};
+const u32_t SVFGBinaryVersion = 1;
+
+enum SVFGBinaryNodeKind
+{
+    BinFormalIN,
+    BinFormalOUT,
+    BinActualIN,
+    BinActualOUT,
+    BinPHI
+};
+
+enum SVFGBinaryEdgeKind
+{
+    /// intra indirect edge from a def to a use, carrying a region's points-to set
+    BinIntraEdge,
+    /// actual-in to formal-in
+    BinCallEdge,
+    /// formal-out to actual-out
+    BinRetEdge,
+    /// end of the edge section
+    BinEdgeEnd
+};
+
+inline void writeVarInt(std::ostream& f, u64_t val)
+{
+    do
+    {
+        u8_t byte = val & 0x7f;
+        val >>= 7;
+        if (val)
+            byte |= 0x80;
+        f.put(static_cast<char>(byte));
+    }
+    while (val);
+}
+
+/// A truncated or overlong encoding sets failbit on f
+inline u64_t readVarInt(std::istream& f)
+{
+    u64_t val = 0;
+    u32_t shift = 0;
+    int c;
+    while ((c = f.get()) != EOF)
+    {
+        if (shift > 63)
+            break;
+        val |= static_cast<u64_t>(c & 0x7f) << shift;
+        if (!(c & 0x80))
+            return val;
+        shift += 7;
+    }
+    f.setstate(std::ios_base::failbit);
+    return 0;
+}
+
+inline void writePts(std::ostream& f, const NodeBS& pts)
+{
+    writeVarInt(f, pts.count());
+    NodeID last = 0;
+    for (NodeID o : pts)
+    {
+        writeVarInt(f, o - last);
+        last = o;
+    }
+}
+
+inline void readPts(std::istream& f, NodeBS& pts)
+{
+    u64_t num = readVarInt(f);
+    NodeID last = 0;
+    for (u64_t i = 0; i < num && f.good(); ++i)
+    {
+        u64_t id = last + readVarInt(f);
+        if (id > std::numeric_limits<NodeID>::max())
+        {
+            f.setstate(std::ios_base::failbit);
+            return;
+        }
+        last = id;
+        pts.set(last);
+    }
+}
+
+} // End anonymous namespace
+
 // Format of file
 // __Nodes__
 // SVFGNodeID: <id> >= <node type> >= MVER: {MRVERID: <id> MemRegion: pts{<pts> } MRVERSION: <version> MSSADef: <version>, pts{<pts> }} >= ICFGNodeID: <id>
@@ -45,6 +145,11 @@ using namespace std;
 // srcSVFGNodeID: <id> => dstSVFGNodeID: <id> >= <edge type> | MVER: {MRVERID: <id> MemRegion: pts{<pts> } MRVERSION: <version> MSSADef: <version>, pts{<pts> }}
 void SVFG::writeToFile(const string& filename)
 {
+    if (Options::SVFGBinaryFormat())
+    {
+        writeToBinaryFile(filename);
+        return;
+    }
     outs() << "Writing SVFG analysis to '" << filename << "'...";
     error_code err;
     std::fstream f(filename.c_str(), std::ios_base::out);
@@ -205,6 +310,11 @@ void SVFG::writeToFile(const string& filename)
 
 void SVFG::readFile(const string& filename)
 {
+    if (isBinarySVFGFile(filename))
+    {
+        readBinaryFile(filename);
+        return;
+    }
     outs() << "Loading SVFG analysis results from '" << filename << "'...";
     ifstream F(filename.c_str());
     if (!F.is_open())
@@ -476,4 +586,450 @@ MRVer* SVFG::getMRVERFromString(const string& s)
     // create mrver
     tempMRVer = new MRVer(tempMemRegion, obj2, tempDef);
     return tempMRVer;
-}
\ No newline at end of file
+}
+
+bool SVFG::isBinarySVFGFile(const string& filename)
+{
+    ifstream F(filename.c_str(), std::ios_base::in | std::ios_base::binary);
+    char magic[sizeof(SVFGBinaryMagic)];
+    if (!F.read(magic, sizeof(magic)))
+        return false;
+    return std::equal(magic, magic + sizeof(magic), SVFGBinaryMagic);
+}
+
+void SVFG::writeToBinaryFile(const string& filename)
+{
+    outs() << "Writing SVFG analysis to '" << filename << "' (binary)...";
+    std::ofstream f(filename.c_str(), std::ios_base::out | std::ios_base::binary);
+    if (!f.good())
+    {
+        outs() << "  error opening file for writing!\n";
+        return;
+    }
+
+    // Collect the region and version tables first so that node and edge
+    // records can refer to them by index
+    Map<const MemRegion*, u32_t> mrToIdx;
+    std::vector<const MemRegion*> regions;
+    auto addRegion = [&](const MemRegion* mr)
+    {
+        if (mrToIdx.emplace(mr, regions.size()).second)
+            regions.push_back(mr);
+    };
+    for (const MemRegion* mr : mssa->getMRGenerator()->getMRSet())
+        addRegion(mr);
+
+    Map<const MRVer*, u32_t> verToIdx;
+    std::vector<const MRVer*> vers;
+    auto addVer = [&](const MRVer* ver)
+    {
+        if (verToIdx.emplace(ver, vers.size()).second)
+        {
+            vers.push_back(ver);
+            addRegion(ver->getMR());
+        }
+    };
+    u32_t numNodes = 0;
+    for (iterator it = begin(), eit = end(); it != eit; ++it)
+    {
+        const SVFGNode* node = it->second;
+        if (const MRSVFGNode* mrNode = SVFUtil::dyn_cast<MRSVFGNode>(node))
+        {
+            if (const MSSAPHISVFGNode* phiNode = SVFUtil::dyn_cast<MSSAPHISVFGNode>(mrNode))
+            {
+                addVer(phiNode->getResVer());
+                for (MemSSA::PHI::OPVers::const_iterator oit = phiNode->opVerBegin(), oeit = phiNode->opVerEnd(); oit != oeit; ++oit)
+                    addVer(oit->second);
+            }
+            else if (const FormalINSVFGNode* formalIn = SVFUtil::dyn_cast<FormalINSVFGNode>(mrNode))
+                addVer(formalIn->getMRVer());
+            else if (const FormalOUTSVFGNode* formalOut = SVFUtil::dyn_cast<FormalOUTSVFGNode>(mrNode))
+                addVer(formalOut->getMRVer());
+            else if (const ActualINSVFGNode* actualIn = SVFUtil::dyn_cast<ActualINSVFGNode>(mrNode))
+                addVer(actualIn->getMRVer());
+            else if (const ActualOUTSVFGNode* actualOut = SVFUtil::dyn_cast<ActualOUTSVFGNode>(mrNode))
+                addVer(actualOut->getMRVer());
+            else
+                continue;
+            ++numNodes;
+        }
+    }
+
+    f.write(SVFGBinaryMagic, sizeof(SVFGBinaryMagic));
+    writeVarInt(f, SVFGBinaryVersion);
+
+    writeVarInt(f, regions.size());
+    for (const MemRegion* mr : regions)
+        writePts(f, mr->getPointsTo());
+
+    writeVarInt(f, vers.size());
+    for (const MRVer* ver : vers)
+    {
+        writeVarInt(f, mrToIdx[ver->getMR()]);
+        writeVarInt(f, ver->getSSAVersion());
+        writeVarInt(f, ver->getDef()->getType());
+    }
+
+    writeVarInt(f, numNodes);
+    for (iterator it = begin(), eit = end(); it != eit; ++it)
+    {
+        NodeID nodeId = it->first;
+        const SVFGNode* node = it->second;
+        if (const FormalINSVFGNode* formalIn = SVFUtil::dyn_cast<FormalINSVFGNode>(node))
+        {
+            writeVarInt(f, BinFormalIN);
+            writeVarInt(f, nodeId);
+            writeVarInt(f, verToIdx[formalIn->getMRVer()]);
+            writeVarInt(f, formalIn->getFunEntryNode()->getId());
+        }
+        else if (const FormalOUTSVFGNode* formalOut = SVFUtil::dyn_cast<FormalOUTSVFGNode>(node))
+        {
+            writeVarInt(f, BinFormalOUT);
+            writeVarInt(f, nodeId);
+            writeVarInt(f, verToIdx[formalOut->getMRVer()]);
+            writeVarInt(f, formalOut->getFunExitNode()->getId());
+        }
+        else if (const ActualINSVFGNode* actualIn = SVFUtil::dyn_cast<ActualINSVFGNode>(node))
+        {
+            writeVarInt(f, BinActualIN);
+            writeVarInt(f, nodeId);
+            writeVarInt(f, verToIdx[actualIn->getMRVer()]);
+            writeVarInt(f, actualIn->getCallSite()->getId());
+        }
+        else if (const ActualOUTSVFGNode* actualOut = SVFUtil::dyn_cast<ActualOUTSVFGNode>(node))
+        {
+            writeVarInt(f, BinActualOUT);
+            writeVarInt(f, nodeId);
+            writeVarInt(f, verToIdx[actualOut->getMRVer()]);
+            writeVarInt(f, actualOut->getCallSite()->getId());
+        }
+        else if (const MSSAPHISVFGNode* phiNode = SVFUtil::dyn_cast<MSSAPHISVFGNode>(node))
+        {
+            writeVarInt(f, BinPHI);
+            writeVarInt(f, nodeId);
+            writeVarInt(f, verToIdx[phiNode->getResVer()]);
+            writeVarInt(f, phiNode->getICFGNode()->getBB()->front()->getId());
+            writeVarInt(f, phiNode->getOpVerNum());
+            for (MemSSA::PHI::OPVers::const_iterator oit = phiNode->opVerBegin(), oeit = phiNode->opVerEnd(); oit != oeit; ++oit)
+            {
+                writeVarInt(f, oit->first);
+                writeVarInt(f, verToIdx[oit->second]);
+            }
+        }
+    }
+
+    auto writeIntraEdge = [&](NodeID def, NodeID use, const MemRegion* mr)
+    {
+        Map<const MemRegion*, u32_t>::const_iterator rit = mrToIdx.find(mr);
+        assert(rit != mrToIdx.end() && "memory region not in the region table?");
+        writeVarInt(f, BinIntraEdge);
+        writeVarInt(f, def);
+        writeVarInt(f, use);
+        writeVarInt(f, rit->second);
+    };
+    for (iterator it = begin(), eit = end(); it != eit; ++it)
+    {
+        NodeID nodeId = it->first;
+        const SVFGNode* node = it->second;
+        if (const LoadSVFGNode* loadNode = SVFUtil::dyn_cast<LoadSVFGNode>(node))
+        {
+            MUSet& muSet = mssa->getMUSet(SVFUtil::cast<LoadStmt>(loadNode->getSVFStmt()));
+            for (MUSet::iterator mit = muSet.begin(), meit = muSet.end(); mit != meit; ++mit)
+            {
+                if (LOADMU* mu = SVFUtil::dyn_cast<LOADMU>(*mit))
+                    writeIntraEdge(getDef(mu->getMRVer()), nodeId, mu->getMRVer()->getMR());
+            }
+        }
+        else if (const StoreSVFGNode* storeNode = SVFUtil::dyn_cast<StoreSVFGNode>(node))
+        {
+            CHISet& chiSet = mssa->getCHISet(SVFUtil::cast<StoreStmt>(storeNode->getSVFStmt()));
+            for (CHISet::iterator cit = chiSet.begin(), ceit = chiSet.end(); cit != ceit; ++cit)
+            {
+                if (STORECHI* chi = SVFUtil::dyn_cast<STORECHI>(*cit))
+                    writeIntraEdge(getDef(chi->getOpVer()), nodeId, chi->getOpVer()->getMR());
+            }
+        }
+        else if (const FormalINSVFGNode* formalIn = SVFUtil::dyn_cast<FormalINSVFGNode>(node))
+        {
+            CallGraphEdge::CallInstSet callInstSet;
+            mssa->getPTA()->getCallGraph()->getDirCallSitesInvokingCallee(formalIn->getFun(), callInstSet);
+            for (const CallICFGNode* cs : callInstSet)
+            {
+                if (!mssa->hasMU(cs))
+                    continue;
+                for (NodeID actualIn : getActualINSVFGNodes(cs))
+                {
+                    writeVarInt(f, BinCallEdge);
+                    writeVarInt(f, actualIn);
+                    writeVarInt(f, nodeId);
+                }
+            }
+        }
+        else if (const FormalOUTSVFGNode* formalOut = SVFUtil::dyn_cast<FormalOUTSVFGNode>(node))
+        {
+            CallGraphEdge::CallInstSet callInstSet;
+            mssa->getPTA()->getCallGraph()->getDirCallSitesInvokingCallee(formalOut->getFun(), callInstSet);
+            for (const CallICFGNode* cs : callInstSet)
+            {
+                if (!mssa->hasCHI(cs))
+                    continue;
+                for (NodeID actualOut : getActualOUTSVFGNodes(cs))
+                {
+                    writeVarInt(f, BinRetEdge);
+                    writeVarInt(f, nodeId);
+                    writeVarInt(f, actualOut);
+                }
+            }
+            writeIntraEdge(getDef(formalOut->getMRVer()), nodeId, formalOut->getMRVer()->getMR());
+        }
+        else if (const ActualINSVFGNode* actualIn = SVFUtil::dyn_cast<ActualINSVFGNode>(node))
+        {
+            writeIntraEdge(getDef(actualIn->getMRVer()), nodeId, actualIn->getMRVer()->getMR());
+        }
+        else if (const MSSAPHISVFGNode* phiNode = SVFUtil::dyn_cast<MSSAPHISVFGNode>(node))
+        {
+            for (MemSSA::PHI::OPVers::const_iterator oit = phiNode->opVerBegin(), oeit = phiNode->opVerEnd(); oit != oeit; ++oit)
+                writeIntraEdge(getDef(oit->second), nodeId, oit->second->getMR());
+        }
+    }
+    writeVarInt(f, BinEdgeEnd);
+
+    f.close();
+    if (f.good())
+        outs() << "\n";
+    else
+        outs() << "  error writing file!\n";
+}
+
+void SVFG::readBinaryFile(const string& filename)
+{
+    outs() << "Loading SVFG analysis results from '" << filename << "' (binary)...";
+    ifstream F(filename.c_str(), std::ios_base::in | std::ios_base::binary);
+    if (!F.is_open())
+    {
+        outs() << " error opening file for reading!\n";
+        return;
+    }
+    char magic[sizeof(SVFGBinaryMagic)];
+    if (!F.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), SVFGBinaryMagic)
+            || readVarInt(F) != SVFGBinaryVersion)
+    {
+        outs() << " unsupported binary SVFG format!\n";
+        return;
+    }
+
+    SVFStmt::SVFStmtSetTy& stores = getSVFStmtSet(SVFStmt::Store);
+    for (SVFStmt::SVFStmtSetTy::iterator iter = stores.begin(), eiter =
+                stores.end(); iter != eiter; ++iter)
+    {
+        StoreStmt* store = SVFUtil::cast<StoreStmt>(*iter);
+        const StmtSVFGNode* sNode = getStmtVFGNode(store);
+        for(CHISet::iterator pi = mssa->getCHISet(store).begin(), epi = mssa->getCHISet(store).end(); pi!=epi; ++pi)
+            setDef((*pi)->getResVer(),sNode);
+    }
+
+    /// Every field is checked once read, as a malformed file would otherwise
+    /// index past the tables or create nodes of the wrong kind. A malformed
+    /// file is reported like an unreadable one; the nodes read so far are kept.
+    std::streampos dataStart = F.tellg();
+    std::streampos fileEnd = F.seekg(0, std::ios_base::end).tellg();
+    F.seekg(dataStart);
+    auto malformed = [&](const char* what)
+    {
+        outs() << " malformed binary SVFG file (" << what << ")!\n";
+        return false;
+    };
+    auto readField = [&](u64_t& val, const char* what)
+    {
+        val = readVarInt(F);
+        return F.good() || malformed(what);
+    };
+    /// Each counted entry takes at least one byte, so a count cannot exceed the bytes left
+    auto readCount = [&](u64_t& count, const char* what)
+    {
+        return readField(count, what) && (count <= u64_t(fileEnd - F.tellg()) || malformed(what));
+    };
+    auto readIndex = [&](u32_t& idx, u64_t size, const char* what)
+    {
+        u64_t val;
+        if (!readField(val, what) || val >= size)
+            return malformed(what);
+        idx = val;
+        return true;
+    };
+    auto readU32 = [&](u32_t& val, const char* what)
+    {
+        return readIndex(val, u64_t(std::numeric_limits<u32_t>::max()) + 1, what);
+    };
+    auto readNodeID = [&](NodeID& id, const char* what)
+    {
+        return readU32(id, what) && (hasSVFGNode(id) || malformed(what));
+    };
+
+    u64_t count;
+    if (!readCount(count, "region count"))
+        return;
+    std::vector<const MemRegion*> regions;
+    regions.reserve(count);
+    for (u64_t i = 0; i < count; ++i)
+    {
+        NodeBS pts;
+        readPts(F, pts);
+        if (!F.good())
+        {
+            malformed("region");
+            return;
+        }
+        regions.push_back(new MemRegion(pts));
+    }
+
+    if (!readCount(count, "version count"))
+        return;
+    std::vector<const MRVer*> vers;
+    vers.reserve(count);
+    for (u64_t i = 0; i < count; ++i)
+    {
+        u32_t mrIdx;
+        u64_t version, defType;
+        if (!readIndex(mrIdx, regions.size(), "region index") || !readField(version, "version")
+                || !readField(defType, "def type"))
+            return;
+        const MemRegion* mr = regions[mrIdx];
+        vers.push_back(new MRVer(mr, version, new MSSADEF(static_cast<MSSADEF::DEFTYPE>(defType), mr)));
+    }
+
+    ICFG* icfg = pag->getICFG();
+    stat->ATVFNodeStart();
+    u64_t numNodes;
+    if (!readCount(numNodes, "node count"))
+        return;
+    for (u64_t i = 0; i < numNodes; ++i)
+    {
+        u64_t kind;
+        NodeID id, icfgId;
+        u32_t verIdx;
+        if (!readField(kind, "node kind") || !readU32(id, "node id"))
+            return;
+        if (hasSVFGNode(id))
+        {
+            malformed("duplicate node id");
+            return;
+        }
+        if (!readIndex(verIdx, vers.size(), "version index") || !readU32(icfgId, "ICFG node id"))
+            return;
+        if (!icfg->hasICFGNode(icfgId))
+        {
+            malformed("ICFG node id");
+            return;
+        }
+        const MRVer* ver = vers[verIdx];
+        ICFGNode* icfgNode = icfg->getICFGNode(icfgId);
+        switch (kind)
+        {
+        case BinFormalIN:
+            if (!SVFUtil::isa<FunEntryICFGNode>(icfgNode))
+            {
+                malformed("formal-in ICFG node");
+                return;
+            }
+            addFormalINSVFGNode(SVFUtil::cast<FunEntryICFGNode>(icfgNode), ver, id);
+            break;
+        case BinFormalOUT:
+            if (!SVFUtil::isa<FunExitICFGNode>(icfgNode))
+            {
+                malformed("formal-out ICFG node");
+                return;
+            }
+            addFormalOUTSVFGNode(SVFUtil::cast<FunExitICFGNode>(icfgNode), ver, id);
+            break;
+        case BinActualIN:
+            if (!SVFUtil::isa<CallICFGNode>(icfgNode))
+            {
+                malformed("actual-in ICFG node");
+                return;
+            }
+            addActualINSVFGNode(SVFUtil::cast<CallICFGNode>(icfgNode), ver, id);
+            break;
+        case BinActualOUT:
+            if (!SVFUtil::isa<CallICFGNode>(icfgNode))
+            {
+                malformed("actual-out ICFG node");
+                return;
+            }
+            addActualOUTSVFGNode(SVFUtil::cast<CallICFGNode>(icfgNode), ver, id);
+            break;
+        case BinPHI:
+        {
+            Map<u32_t,const MRVer*> opVers;
+            u64_t numOps;
+            if (!readCount(numOps, "phi operand count"))
+                return;
+            for (u64_t op = 0; op < numOps; ++op)
+            {
+                u32_t pos, opIdx;
+                if (!readU32(pos, "phi operand position") || !readIndex(opIdx, vers.size(), "version index"))
+                    return;
+                opVers[pos] = vers[opIdx];
+            }
+            addIntraMSSAPHISVFGNode(icfgNode, opVers.begin(), opVers.end(), ver, id);
+            break;
+        }
+        default:
+            malformed("node kind");
+            return;
+        }
+        if (totalVFGNode <= id)
+            totalVFGNode = id + 1;
+    }
+    stat->ATVFNodeEnd();
+
+    stat->indVFEdgeStart();
+    while (true)
+    {
+        u64_t kind;
+        NodeID src, dst;
+        if (!readField(kind, "edge kind"))
+            return;
+        if (kind == BinEdgeEnd)
+            break;
+        if (!readNodeID(src, "edge src") || !readNodeID(dst, "edge dst"))
+            return;
+        if (kind == BinIntraEdge)
+        {
+            u32_t mrIdx;
+            if (!readIndex(mrIdx, regions.size(), "region index"))
+                return;
+            addIntraIndirectVFEdge(src, dst, regions[mrIdx]->getPointsTo());
+        }
+        else if (kind == BinCallEdge)
+        {
+            const ActualINSVFGNode* actualIn = SVFUtil::dyn_cast<ActualINSVFGNode>(getSVFGNode(src));
+            const FormalINSVFGNode* formalIn = SVFUtil::dyn_cast<FormalINSVFGNode>(getSVFGNode(dst));
+            if (actualIn == nullptr || formalIn == nullptr)
+            {
+                malformed("call edge");
+                return;
+            }
+            addInterIndirectVFCallEdge(actualIn, formalIn, getCallSiteID(actualIn->getCallSite(), formalIn->getFun()));
+        }
+        else if (kind == BinRetEdge)
+        {
+            const FormalOUTSVFGNode* formalOut = SVFUtil::dyn_cast<FormalOUTSVFGNode>(getSVFGNode(src));
+            const ActualOUTSVFGNode* actualOut = SVFUtil::dyn_cast<ActualOUTSVFGNode>(getSVFGNode(dst));
+            if (formalOut == nullptr || actualOut == nullptr)
+            {
+                malformed("ret edge");
+                return;
+            }
+            addInterIndirectVFRetEdge(formalOut, actualOut, getCallSiteID(actualOut->getCallSite(), formalOut->getFun()));
+        }
+        else
+        {
+            malformed("edge kind");
+            return;
+        }
+    }
+    stat->indVFEdgeEnd();
+    connectFromGlobalToProgEntry();
+    outs() << "\n";
+}
@@ -238,6 +238,12 @@ void SVFGStat::performStat()
     PTNumStatMap["MaxIndInDeg"] = maxIndInDegree;
     PTNumStatMap["MaxIndOutDeg"] = maxIndOutDegree;
 
+    if (graph->isOnDemand())
+    {
+        PTNumStatMap["MaterializedFun"] = graph->getMaterializedFuns().size();
+        PTNumStatMap["OnDemandFun"] = graph->getOnDemandFunNum();
+    }
+
     printStat();
 }
 
@@ -182,38 +182,32 @@ void MRGenerator::collectModRefForLoadStore()
         if (Options::IgnoreDeadFun() && fun.isUncalledFunction())
             continue;
 
-        for (FunObjVar::const_bb_iterator iter = fun.begin(), eiter = fun.end();
-                iter != eiter; ++iter)
+        /// one pass in program order, so that regions are created in the same order as
+        /// when walking the basic blocks of fun
+        SVFIR* pag = pta->getPAG();
+        for (const SVFStmt* stmt : pag->getFunSVFStmts(&fun))
         {
-            const SVFBasicBlock* bb = iter->second;
-            for (const auto& inst: bb->getICFGNodeList())
+            if (ptrOnlyMSSA && !stmt->isPTAEdge())
+                continue;
+            pagEdgeToFunMap[stmt] = &fun;
+            if (const StoreStmt *st = SVFUtil::dyn_cast<StoreStmt>(stmt))
             {
-                SVFStmtList& pagEdgeList = getSVFStmtsFromInst(inst);
-                for (SVFStmtList::iterator bit = pagEdgeList.begin(), ebit =
-                            pagEdgeList.end(); bit != ebit; ++bit)
-                {
-                    const PAGEdge* inst = *bit;
-                    pagEdgeToFunMap[inst] = &fun;
-                    if (const StoreStmt *st = SVFUtil::dyn_cast<StoreStmt>(inst))
-                    {
-                        NodeBS cpts(pta->getPts(st->getLHSVarID()).toNodeBS());
-                        // TODO: change this assertion check later when we have conditional points-to set
-                        if (cpts.empty())
-                            continue;
-                        assert(!cpts.empty() && "null pointer!!");
-                        addCPtsToStore(cpts, st, &fun);
-                    }
-
-                    else if (const LoadStmt *ld = SVFUtil::dyn_cast<LoadStmt>(inst))
-                    {
-                        NodeBS cpts(pta->getPts(ld->getRHSVarID()).toNodeBS());
-                        // TODO: change this assertion check later when we have conditional points-to set
-                        if (cpts.empty())
-                            continue;
-                        assert(!cpts.empty() && "null pointer!!");
-                        addCPtsToLoad(cpts, ld, &fun);
-                    }
-                }
+                NodeBS cpts(pta->getPts(st->getLHSVarID()).toNodeBS());
+                // TODO: change this assertion check later when we have conditional points-to set
+                if (cpts.empty())
+                    continue;
+                assert(!cpts.empty() && "null pointer!!");
+                addCPtsToStore(cpts, st, &fun);
+            }
+
+            else if (const LoadStmt *ld = SVFUtil::dyn_cast<LoadStmt>(stmt))
+            {
+                NodeBS cpts(pta->getPts(ld->getRHSVarID()).toNodeBS());
+                // TODO: change this assertion check later when we have conditional points-to set
+                if (cpts.empty())
+                    continue;
+                assert(!cpts.empty() && "null pointer!!");
+                addCPtsToLoad(cpts, ld, &fun);
             }
         }
     }
@@ -60,6 +60,13 @@ void SVFGBuilder::buildSVFG()
 /// Create DDA SVFG
 SVFG* SVFGBuilder::build(BVDataPTAImpl* pta, VFG::VFGK kind)
 {
+    /// the optimised SVFG and SVFG files need the whole graph at once
+    if (onDemand && (kind == VFG::FULLSVFG_OPT || kind == VFG::PTRONLYSVFG_OPT
+                     || !Options::ReadSVFG().empty() || !Options::WriteSVFG().empty()))
+    {
+        writeWrnMsg("-svfg-on-demand ignored with -opt-svfg, -read-svfg or -write-svfg");
+        onDemand = false;
+    }
 
     auto mssa = buildMSSA(
                     pta, (VFG::PTRONLYSVFG == kind || VFG::PTRONLYSVFG_OPT == kind));
@@ -69,6 +76,8 @@ SVFG* SVFGBuilder::build(BVDataPTAImpl* pta, VFG::VFGK kind)
         svfg = std::make_unique<SVFGOPT>(std::move(mssa), kind);
     else
         svfg = std::unique_ptr<SVFG>(new SVFG(std::move(mssa), kind));
+    if (onDemand)
+        svfg->enableOnDemand();
     buildSVFG();
 
     /// Update call graph using pre-analysis results
@@ -84,6 +93,15 @@ SVFG* SVFGBuilder::build(BVDataPTAImpl* pta, VFG::VFGK kind)
     return svfg.get();
 }
 
+/*!
+ * Make all edges of node available before a client traverses them
+ */
+void SVFGBuilder::materializeAround(const SVFGNode* node)
+{
+    if (onDemand)
+        svfg->materializeAround(node);
+}
+
 /*!
  * Release memory
  */
@@ -100,6 +118,10 @@ std::unique_ptr<MemSSA> SVFGBuilder::buildMSSA(BVDataPTAImpl* pta,
 
     auto mssa = std::make_unique<MemSSA>(pta, ptrOnlyMSSA);
 
+    /// in on-demand mode memory SSA of a function is built by SVFG::materializeFun
+    if (onDemand)
+        return mssa;
+
     const CallGraph* svfirCallGraph = PAG::getPAG()->getCallGraph();
     for (const auto& item : *svfirCallGraph)
     {
@@ -559,27 +559,7 @@ bool MHP::isHBPair(NodeID tid1, NodeID tid2)
 
 bool MHP::isConnectedfromMain(const FunObjVar* fun)
 {
-    CallGraphNode* cgnode = tcg->getCallGraphNode(fun);
-    FIFOWorkList<const CallGraphNode*> worklist;
-    TCT::PTACGNodeSet visited;
-    worklist.push(cgnode);
-    visited.insert(cgnode);
-    while (!worklist.empty())
-    {
-        const CallGraphNode* node = worklist.pop();
-        if (SVFUtil::isProgEntryFunction(node->getFunction()))
-            return true;
-        for (CallGraphNode::const_iterator nit = node->InEdgeBegin(), neit = node->InEdgeEnd(); nit != neit; nit++)
-        {
-            const CallGraphNode* srcNode = (*nit)->getSrcNode();
-            if (visited.find(srcNode) == visited.end())
-            {
-                visited.insert(srcNode);
-                worklist.push(srcNode);
-            }
-        }
-    }
-    return false;
+    return tcg->isReachableFromProgEntry(fun);
 }
 
 /*!
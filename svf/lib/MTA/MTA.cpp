@@ -134,29 +134,14 @@ void MTA::detect()
     SVFIR* pag = SVFIR::getPAG();
     PointerAnalysis* pta = AndersenWaveDiff::createAndersenWaveDiff(pag);
 
-    // Add symbols for all of the functions and the instructions in them.
-    for (const auto& item : *PAG::getPAG()->getCallGraph())
+    // Collect the loads and stores of the functions in the call graph from their statement slices
+    for (const auto& item : *pag->getCallGraph())
     {
         const FunObjVar* F = item.second->getFunction();
-        // collect and create symbols inside the function body
-        for (auto it : *F)
-        {
-            const SVFBasicBlock* svfbb = it.second;
-            for (const ICFGNode* icfgNode : svfbb->getICFGNodeList())
-            {
-                for(const SVFStmt* stmt : pag->getSVFStmtList(icfgNode))
-                {
-                    if (const LoadStmt* l = SVFUtil::dyn_cast<LoadStmt>(stmt))
-                    {
-                        loads.insert(l);
-                    }
-                    else if (const StoreStmt* s = SVFUtil::dyn_cast<StoreStmt>(stmt))
-                    {
-                        stores.insert(s);
-                    }
-                }
-            }
-        }
+        for (const SVFStmt* stmt : pag->getFunSVFStmts(SVFStmt::Load, F))
+            loads.insert(SVFUtil::cast<LoadStmt>(stmt));
+        for (const SVFStmt* stmt : pag->getFunSVFStmts(SVFStmt::Store, F))
+            stores.insert(SVFUtil::cast<StoreStmt>(stmt));
     }
 
     for (Set<const LoadStmt*>::const_iterator lit = loads.begin(), elit = loads.end(); lit != elit; ++lit)
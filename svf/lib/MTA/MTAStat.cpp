@@ -125,24 +125,14 @@ void MTAStat::performMHPPairStat(MHP* mhp, LockAnalysis* lsa)
                 continue;
             if(!mhp->isConnectedfromMain(fun))
                 continue;
-            for (FunObjVar::const_bb_iterator bit =  fun->begin(), ebit = fun->end(); bit != ebit; ++bit)
+            for (const SVFStmt* load : pag->getFunSVFStmts(SVFStmt::Load, fun))
             {
-                const SVFBasicBlock* bb = bit->second;
-                for (const auto& icfgNode : bb->getICFGNodeList())
-                {
-                    for(const SVFStmt* stmt : pag->getSVFStmtList(icfgNode))
-                    {
-                        if(SVFUtil::isa<LoadStmt>(stmt))
-                        {
-                            instSet1.insert(stmt->getICFGNode());
-                        }
-                        else if(SVFUtil::isa<StoreStmt>(stmt))
-                        {
-                            instSet1.insert(stmt->getICFGNode());
-                            instSet2.insert(stmt->getICFGNode());
-                        }
-                    }
-                }
+                instSet1.insert(load->getICFGNode());
+            }
+            for (const SVFStmt* store : pag->getFunSVFStmts(SVFStmt::Store, fun))
+            {
+                instSet1.insert(store->getICFGNode());
+                instSet2.insert(store->getICFGNode());
             }
         }
 
@@ -46,11 +46,25 @@ u32_t ContextCond::maximumCxt = 0;
 u32_t ContextCond::maximumPathLen = 0;
 u32_t ContextCond::maximumPath = 0;
 u32_t SaberCondAllocator::totalCondNum = 0;
+u32_t SaberCondAllocator::numAllocators = 0;
+bool SaberCondition::useBDD = false;
 
 
 SaberCondAllocator::SaberCondAllocator()
 {
+    SaberCondition::selectEngine(Options::SaberBDD());
+    numAllocators++;
+}
 
+/*!
+ * Conditions held by the members of this allocator (and of its checker) are
+ * dropped without a manager once the last allocator has released it
+ */
+SaberCondAllocator::~SaberCondAllocator()
+{
+    destroy();
+    if (--numAllocators == 0 && SaberCondition::isBDD())
+        BDDExpr::releaseManager();
 }
 
 /*!
@@ -485,6 +499,9 @@ SaberCondAllocator::getPHIComplementCond(const SVFBasicBlock* BB1, const SVFBasi
  * Compute calling inter-procedural guards between two SVFGNodes (from caller to callee)
  * src --c1--> callBB --true--> funEntryBB --c2--> dst
  * the InterCallVFGGuard is c1 ^ c2
+ * c1 is never taken from intraGuardCache: the block conditions its walk leaves
+ * in bbToCondMap are read afterwards (callBB here, and every caller block when
+ * the callee is the caller itself), and a cache hit would not set them.
  */
 SaberCondAllocator::Condition
 SaberCondAllocator::ComputeInterCallVFGGuard(const SVFBasicBlock* srcBB, const SVFBasicBlock* dstBB,
@@ -492,7 +509,7 @@ SaberCondAllocator::ComputeInterCallVFGGuard(const SVFBasicBlock* srcBB, const S
 {
     const SVFBasicBlock* funEntryBB = dstBB->getParent()->getEntryBlock();
 
-    Condition c1 = ComputeIntraVFGGuard(srcBB, callBB);
+    Condition c1 = computeIntraVFGGuard(srcBB, callBB, false);
     setCFCond(funEntryBB, condOr(getCFCond(funEntryBB), getCFCond(callBB)));
     Condition c2 = ComputeIntraVFGGuard(funEntryBB, dstBB);
     return condAnd(c1, c2);
@@ -502,6 +519,7 @@ SaberCondAllocator::ComputeInterCallVFGGuard(const SVFBasicBlock* srcBB, const S
  * Compute return inter-procedural guards between two SVFGNodes (from callee to caller)
  * src --c1--> funExitBB --true--> retBB --c2--> dst
  * the InterRetVFGGuard is c1 ^ c2
+ * As for call guards, c1 is always walked so that bbToCondMap holds its block conditions.
  */
 SaberCondAllocator::Condition
 SaberCondAllocator::ComputeInterRetVFGGuard(const SVFBasicBlock* srcBB, const SVFBasicBlock* dstBB, const SVFBasicBlock* retBB)
@@ -509,7 +527,7 @@ SaberCondAllocator::ComputeInterRetVFGGuard(const SVFBasicBlock* srcBB, const SV
     const FunObjVar* parent = srcBB->getParent();
     const SVFBasicBlock* funExitBB = parent->getExitBB();
 
-    Condition c1 = ComputeIntraVFGGuard(srcBB, funExitBB);
+    Condition c1 = computeIntraVFGGuard(srcBB, funExitBB, false);
     setCFCond(retBB, condOr(getCFCond(retBB), getCFCond(funExitBB)));
     Condition c2 = ComputeIntraVFGGuard(retBB, dstBB);
     return condAnd(c1, c2);
@@ -519,6 +537,11 @@ SaberCondAllocator::ComputeInterRetVFGGuard(const SVFBasicBlock* srcBB, const SV
  * Compute intra-procedural guards between two SVFGNodes (inside same function)
  */
 SaberCondAllocator::Condition SaberCondAllocator::ComputeIntraVFGGuard(const SVFBasicBlock* srcBB, const SVFBasicBlock* dstBB)
+{
+    return computeIntraVFGGuard(srcBB, dstBB, true);
+}
+
+SaberCondAllocator::Condition SaberCondAllocator::computeIntraVFGGuard(const SVFBasicBlock* srcBB, const SVFBasicBlock* dstBB, bool cacheable)
 {
 
     assert(srcBB->getParent() == dstBB->getParent() && "two basic blocks are not in the same function??");
@@ -526,6 +549,35 @@ SaberCondAllocator::Condition SaberCondAllocator::ComputeIntraVFGGuard(const SVF
     if (postDominate(dstBB, srcBB))
         return getTrueCond();
 
+    if (!cacheable)
+        return walkIntraVFGGuard(srcBB, dstBB);
+
+    /// The walk only reads and writes conditions of this function's basic blocks and resets that of srcBB,
+    /// so its result only depends on (srcBB, dstBB, evaluated node) if no other block of the function
+    /// still carries a condition from an earlier walk (e.g. the caller part of a recursive call guard)
+    const FunObjVar* fun = srcBB->getParent();
+    Map<const FunObjVar*, u32_t>::const_iterator nit = funToCFCondNum.find(fun);
+    u32_t staleNum = (nit == funToCFCondNum.end()) ? 0 : nit->second;
+    if (staleNum > 0 && bbToCondMap.find(srcBB) != bbToCondMap.end())
+        staleNum--;
+    if (staleNum > 0)
+        return walkIntraVFGGuard(srcBB, dstBB);
+
+    GuardKey key(std::make_pair(srcBB, dstBB), getGuardEvalNode(fun));
+    guardQueryNum++;
+    GuardCache::const_iterator it = intraGuardCache.find(key);
+    if (it != intraGuardCache.end())
+    {
+        guardHitNum++;
+        return it->second;
+    }
+    Condition guard = walkIntraVFGGuard(srcBB, dstBB);
+    intraGuardCache.emplace(key, guard);
+    return guard;
+}
+
+SaberCondAllocator::Condition SaberCondAllocator::walkIntraVFGGuard(const SVFBasicBlock* srcBB, const SVFBasicBlock* dstBB)
+{
     CFWorkList worklist;
     worklist.push(srcBB);
     setCFCond(srcBB, getTrueCond());
@@ -569,6 +621,56 @@ SaberCondAllocator::Condition SaberCondAllocator::ComputeIntraVFGGuard(const SVF
 }
 
 
+/*!
+ * Branch conditions are only evaluated against the current SVFG node by evaluateTestNullLikeExpr,
+ * so guards of functions without a branch on a null comparison are shared by all nodes.
+ * Otherwise the node is the key even without a value, as the null test also matches the
+ * values of its out-edge destinations.
+ */
+const SVFGNode* SaberCondAllocator::getGuardEvalNode(const FunObjVar* fun)
+{
+    const SVFGNode* node = getCurEvalSVFGNode();
+    if (node && hasNullTestBranch(fun))
+        return node;
+    return nullptr;
+}
+
+bool SaberCondAllocator::hasNullTestBranch(const FunObjVar* fun)
+{
+    Map<const FunObjVar*, bool>::const_iterator it = funHasNullTest.find(fun);
+    if (it != funHasNullTest.end())
+        return it->second;
+
+    bool res = false;
+    for (FunObjVar::const_bb_iterator bit = fun->begin(), ebit = fun->end(); bit != ebit && !res; ++bit)
+    {
+        const SVFBasicBlock* bb = bit->second;
+        if (bb->getNumSuccessors() < 2 || bb->getICFGNodeList().empty())
+            continue;
+        for (const SVFStmt* stmt : bb->back()->getSVFStmts())
+        {
+            const BranchStmt* branchStmt = SVFUtil::dyn_cast<BranchStmt>(stmt);
+            if (!branchStmt || branchStmt->getNumSuccessors() != 2)
+                continue;
+            const ICFGNode* test = SVFUtil::cast<ValVar>(branchStmt->getCondition())->getICFGNode();
+            if (!test)
+                continue;
+            // mirror isTestNullExpr/isTestNotNullExpr, which only look at the first comparison
+            for (const SVFStmt* testStmt : PAG::getPAG()->getSVFStmtList(test))
+            {
+                if (const CmpStmt* cmp = SVFUtil::dyn_cast<CmpStmt>(testStmt))
+                {
+                    res |= SVFUtil::isa<ConstNullPtrValVar>(cmp->getOpVar(0)) ||
+                           SVFUtil::isa<ConstNullPtrValVar>(cmp->getOpVar(1));
+                    break;
+                }
+            }
+        }
+    }
+    funHasNullTest[fun] = res;
+    return res;
+}
+
 /*!
  * Print path conditions
  */
@@ -602,7 +704,8 @@ void SaberCondAllocator::printPathCond()
 SaberCondAllocator::Condition SaberCondAllocator::newCond(const ICFGNode* inst)
 {
     u32_t condCountIdx = totalCondNum++;
-    Condition expr = Condition::getContext().bool_const(("c" + std::to_string(condCountIdx)).c_str());
+    Condition expr = Condition::isBDD() ? Condition(BDDExpr::newVar()) :
+                     Condition(Z3Expr(Z3Expr::getContext().bool_const(("c" + std::to_string(condCountIdx)).c_str())));
     Condition negCond = Condition::NEG(expr);
     setCondInst(expr, inst);
     setNegCondInst(negCond, inst);
@@ -615,20 +718,27 @@ SaberCondAllocator::Condition SaberCondAllocator::newCond(const ICFGNode* inst)
 bool SaberCondAllocator::isEquivalentBranchCond(const Condition &lhs,
         const Condition &rhs) const
 {
-    Condition::getSolver().push();
-    Condition::getSolver().add(lhs.getExpr() != rhs.getExpr()); /// check equal using z3 solver
-    z3::check_result res = Condition::getSolver().check();
-    Condition::getSolver().pop();
+    /// BDDs are canonical, so equivalent conditions share one node
+    if (Condition::isBDD())
+        return eq(lhs, rhs);
+
+    Z3Expr::getSolver().push();
+    Z3Expr::getSolver().add(lhs.getZ3Expr().getExpr() != rhs.getZ3Expr().getExpr()); /// check equal using z3 solver
+    z3::check_result res = Z3Expr::getSolver().check();
+    Z3Expr::getSolver().pop();
     return res == z3::unsat;
 }
 
 /// whether condition is satisfiable
 bool SaberCondAllocator::isSatisfiable(const Condition &condition)
 {
-    Condition::getSolver().push();
-    Condition::getSolver().add(condition.getExpr());
-    z3::check_result result = Condition::getSolver().check();
-    Condition::getSolver().pop();
+    if (Condition::isBDD())
+        return !condition.getBDDExpr().isFalse();
+
+    Z3Expr::getSolver().push();
+    Z3Expr::getSolver().add(condition.getZ3Expr().getExpr());
+    z3::check_result result = Z3Expr::getSolver().check();
+    Z3Expr::getSolver().pop();
     if (result == z3::sat || result == z3::unknown)
         return true;
     else
@@ -638,18 +748,33 @@ bool SaberCondAllocator::isSatisfiable(const Condition &condition)
 /// extract subexpression from a Z3 expression
 void SaberCondAllocator::extractSubConds(const Condition &condition, NodeBS &support) const
 {
-    if (condition.getExpr().num_args() == 1 && isNegCond(condition.id()))
+    if (Condition::isBDD())
+    {
+        const BDDExpr& bdd = condition.getBDDExpr();
+        if (bdd.isNull())
+            return;
+        /// the literals of one path to true, each kept alive in conditionVec by newCond
+        BDDManager& manager = BDDExpr::getManager();
+        std::vector<std::pair<u32_t, bool>> path;
+        manager.getOnePath(bdd.id(), path);
+        for (const auto& literal : path)
+            support.set(manager.getLiteral(literal.first, literal.second));
+        return;
+    }
+
+    const z3::expr& expr = condition.getZ3Expr().getExpr();
+    if (expr.num_args() == 1 && isNegCond(expr.id()))
     {
-        support.set(condition.getExpr().id());
+        support.set(expr.id());
         return;
     }
-    if (condition.getExpr().num_args() == 0)
-        if (!condition.getExpr().is_true() && !condition.getExpr().is_false())
-            support.set(condition.getExpr().id());
-    for (u32_t i = 0; i < condition.getExpr().num_args(); ++i)
+    if (expr.num_args() == 0)
+        if (!expr.is_true() && !expr.is_false())
+            support.set(expr.id());
+    for (u32_t i = 0; i < expr.num_args(); ++i)
     {
-        Condition expr = condition.getExpr().arg(i);
-        extractSubConds(expr, support);
+        Condition subExpr = Z3Expr(expr.arg(i));
+        extractSubConds(subExpr, support);
     }
 
 }
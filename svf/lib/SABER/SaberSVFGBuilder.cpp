@@ -259,36 +259,60 @@ void SaberSVFGBuilder::rmIncomingEdgeForSUStore(BVDataPTAImpl* pta)
 {
 
     for(SVFG::iterator it = svfg->begin(), eit = svfg->end(); it!=eit; ++it)
-    {
-        const SVFGNode* node = it->second;
+        rmIncomingEdgeForSUStore(pta, it->second);
+}
 
-        if(const StoreSVFGNode* stmtNode = SVFUtil::dyn_cast<StoreSVFGNode>(node))
+void SaberSVFGBuilder::rmIncomingEdgeForSUStore(BVDataPTAImpl* pta, const SVFGNode* node)
+{
+    if(const StoreSVFGNode* stmtNode = SVFUtil::dyn_cast<StoreSVFGNode>(node))
+    {
+        if(SVFUtil::isa<StoreStmt>(stmtNode->getSVFStmt()))
         {
-            if(SVFUtil::isa<StoreStmt>(stmtNode->getSVFStmt()))
+            NodeID singleton;
+            if(isStrongUpdate(node, singleton, pta))
             {
-                NodeID singleton;
-                if(isStrongUpdate(node, singleton, pta))
+                Set<SVFGEdge*> toRemove;
+                for (SVFGNode::const_iterator it2 = node->InEdgeBegin(), eit2 = node->InEdgeEnd(); it2 != eit2; ++it2)
                 {
-                    Set<SVFGEdge*> toRemove;
-                    for (SVFGNode::const_iterator it2 = node->InEdgeBegin(), eit2 = node->InEdgeEnd(); it2 != eit2; ++it2)
+                    if ((*it2)->isIndirectVFGEdge())
                     {
-                        if ((*it2)->isIndirectVFGEdge())
-                        {
-                            toRemove.insert(*it2);
-                        }
-                    }
-                    for (SVFGEdge* edge: toRemove)
-                    {
-                        if (isa<StoreSVFGNode>(edge->getSrcNode()))
-                            saberCondAllocator->getRemovedSUVFEdges()[edge->getSrcNode()].insert(edge->getDstNode());
-                        svfg->removeSVFGEdge(edge);
+                        toRemove.insert(*it2);
                     }
                 }
+                for (SVFGEdge* edge: toRemove)
+                {
+                    if (isa<StoreSVFGNode>(edge->getSrcNode()))
+                        saberCondAllocator->getRemovedSUVFEdges()[edge->getSrcNode()].insert(edge->getDstNode());
+                    svfg->removeSVFGEdge(edge);
+                }
             }
         }
     }
 }
 
+/*!
+ * Indirect edges of the functions materialized on demand are pruned for strong updates
+ * in the same way as rmIncomingEdgeForSUStore does for the whole SVFG
+ */
+void SaberSVFGBuilder::materializeAround(const SVFGNode* node)
+{
+    if (!isOnDemand())
+        return;
+    SVFGBuilder::materializeAround(node);
+
+    SVFIR* pag = svfg->getPAG();
+    BVDataPTAImpl* pta = svfg->getMSSA()->getPTA();
+    const std::vector<const FunObjVar*>& funs = svfg->getMaterializedFuns();
+    for (; numSUPrunedFuns < funs.size(); ++numSUPrunedFuns)
+    {
+        for (const SVFStmt* stmt : pag->getFunSVFStmts(SVFStmt::Store, funs[numSUPrunedFuns]))
+        {
+            if (svfg->hasStmtVFGNode(stmt))
+                rmIncomingEdgeForSUStore(pta, svfg->getStmtVFGNode(stmt));
+        }
+    }
+}
+
 
 /// Add actual parameter SVFGNode for 1st argument of a deallocation like external function
 void SaberSVFGBuilder::AddExtActualParmSVFGNodes(CallGraph* callgraph)
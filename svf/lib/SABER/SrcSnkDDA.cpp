@@ -44,6 +44,7 @@ void SrcSnkDDA::initialize()
 
     AndersenWaveDiff* ander = AndersenWaveDiff::createAndersenWaveDiff(pag);
     memSSA.setSaberCondAllocator(getSaberCondAllocator());
+    memSSA.setOnDemand(Options::SVFGOnDemand());
     if(Options::SABERFULLSVFG())
         svfg =  memSSA.buildFullSVFG(ander);
     else
@@ -132,6 +133,7 @@ bool SrcSnkDDA::isInAWrapper(const SVFGNode* src, CallSiteSet& csIdSet)
             visited.set(node->getId());
         else
             continue;
+        memSSA.materializeAround(node);
         // reaching maximum steps when traversing on SVFG to identify a memory allocation wrapper
         if (step++ > Options::MaxStepInWrapper())
             return false;
@@ -304,4 +306,16 @@ void SrcSnkDDA::printZ3Stat()
 
     outs() << "Z3 Mem usage: " << getSaberCondAllocator()->getMemUsage() << "\n";
     outs() << "Z3 Number: " << getSaberCondAllocator()->getCondNum() << "\n";
+    u32_t guardQueries = getSaberCondAllocator()->getGuardQueryNum();
+    u32_t guardHits = getSaberCondAllocator()->getGuardHitNum();
+    outs() << "VF Guard Queries: " << guardQueries << "\n";
+    outs() << "VF Guard Cache Hits: " << guardHits << " ("
+           << (guardQueries == 0 ? 0.0 : 100.0 * guardHits / guardQueries) << "%)\n";
+    if (SaberCondition::isBDD())
+    {
+        const BDDManager& manager = BDDExpr::getManager();
+        outs() << "BDD Vars: " << manager.getVarNum() << "\n";
+        outs() << "BDD Live Nodes: " << manager.getLiveNodeNum() << "\n";
+        outs() << "BDD GCs: " << manager.getGCNum() << "\n";
+    }
 }
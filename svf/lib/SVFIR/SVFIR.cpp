@@ -39,10 +39,70 @@ std::unique_ptr<SVFIR> SVFIR::pag;
 
 std::string SVFIR::pagReadFromTxt = "";
 
-SVFIR::SVFIR(bool buildFromFile) : IRGraph(buildFromFile), icfg(nullptr), chgraph(nullptr)
+SVFIR::SVFIR(bool buildFromFile) : IRGraph(buildFromFile), icfg(nullptr), chgraph(nullptr), stmtIndexBuilt(false)
 {
 }
 
+/*!
+ * Lay the statements of all ICFG nodes out contiguously: function by function
+ * (call graph order, then basic blocks, then ICFG nodes), followed by the nodes
+ * outside any basic block in ICFG node order. Each per-kind column keeps this
+ * order, so a function owns one contiguous range of every column.
+ */
+void SVFIR::buildStmtIndex()
+{
+    const u32_t numKinds = SVFStmt::ThreadJoin + 1;
+    flatStmts.clear();
+    icfgNodeToStmtRange.clear();
+    funToStmtRange.clear();
+    kindToFlatStmts.assign(numKinds, SVFStmtList());
+    kindToFunStmtRange.assign(numKinds, FunToStmtRangeMap());
+
+    auto addNodeStmts = [this](const ICFGNode* node)
+    {
+        ICFGNode2SVFStmtsMap::const_iterator it = icfgNode2SVFStmtsMap.find(node);
+        if (it == icfgNode2SVFStmtsMap.end() || icfgNodeToStmtRange.count(node))
+            return;
+        u32_t begin = flatStmts.size();
+        for (const SVFStmt* stmt : it->second)
+        {
+            assert(stmt->getEdgeKind() < numKinds && "unknown statement kind");
+            flatStmts.push_back(stmt);
+            kindToFlatStmts[stmt->getEdgeKind()].push_back(stmt);
+        }
+        icfgNodeToStmtRange[node] = std::make_pair(begin, (u32_t) flatStmts.size());
+    };
+
+    std::vector<u32_t> kindBegin(numKinds);
+    for (const auto& item : *callGraph)
+    {
+        const FunObjVar* fun = item.second->getFunction();
+        u32_t begin = flatStmts.size();
+        for (u32_t k = 0; k < numKinds; ++k)
+            kindBegin[k] = kindToFlatStmts[k].size();
+
+        for (const auto& bbIt : *fun)
+        {
+            for (const ICFGNode* node : bbIt.second->getICFGNodeList())
+                addNodeStmts(node);
+        }
+
+        if (flatStmts.size() == begin)
+            continue;
+        funToStmtRange[fun] = std::make_pair(begin, (u32_t) flatStmts.size());
+        for (u32_t k = 0; k < numKinds; ++k)
+        {
+            if (kindToFlatStmts[k].size() > kindBegin[k])
+                kindToFunStmtRange[k][fun] = std::make_pair(kindBegin[k], (u32_t) kindToFlatStmts[k].size());
+        }
+    }
+
+    for (const auto& item : *icfg)
+        addNodeStmts(item.second);
+
+    stmtIndexBuilt = true;
+}
+
 
 const FunObjVar *SVFIR::getFunObjVar(const std::string &name)
 {
@@ -543,6 +603,22 @@ NodeID SVFIR::getGepObjVar(const BaseObjVar* baseObj, const APOffset& apOffset)
 
 }
 
+/*!
+ * The clone has the type info of obj and is allocated at callSite
+ */
+NodeID SVFIR::getHeapObjClone(const HeapObjVar* obj, const ICFGNode* callSite)
+{
+    NodePair key = std::make_pair(obj->getId(), callSite->getId());
+    NodePairMap::const_iterator iter = heapObjCloneMap.find(key);
+    if (iter != heapObjCloneMap.end())
+        return iter->second;
+
+    NodeID cloneId = NodeIDAllocator::get()->allocateObjectId();
+    addHeapObjNode(cloneId, new ObjTypeInfo(*obj->getTypeInfo()), callSite);
+    heapObjCloneMap[key] = cloneId;
+    return cloneId;
+}
+
 NodeID SVFIR::addGepObjNode(GepObjVar* gepObj, NodeID base, const APOffset& apOffset)
 {
     assert(0==GepObjVarMap.count(std::make_pair(base, apOffset))
@@ -634,6 +710,12 @@ NodeID SVFIR::getGepValVar(NodeID curInst, NodeID base, const AccessPath& ap) co
  */
 void SVFIR::destroy()
 {
+    flatStmts.clear();
+    icfgNodeToStmtRange.clear();
+    funToStmtRange.clear();
+    kindToFlatStmts.clear();
+    kindToFunStmtRange.clear();
+    stmtIndexBuilt = false;
     delete icfg;
     icfg = nullptr;
     delete chgraph;
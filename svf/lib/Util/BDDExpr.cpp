@@ -0,0 +1,293 @@
+//===- BDDExpr.cpp -- ROBDD conditions----------------------------//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+/*
+ * BDDExpr.cpp
+ */
+
+#include "Util/BDDExpr.h"
+#include <algorithm>
+
+using namespace SVF;
+
+namespace
+{
+/// initial sizes (powers of two) of the unique table and the computed cache
+constexpr SVF::u32_t InitBuckets = 1 << 12;
+constexpr SVF::u32_t CacheSize = 1 << 16;
+/// live node count which triggers the first garbage collection
+constexpr SVF::u32_t InitGCThreshold = 1 << 16;
+}
+
+BDDManager* BDDExpr::manager = nullptr;
+
+BDDManager& BDDExpr::getManager()
+{
+    if (manager == nullptr)
+        manager = new BDDManager();
+    return *manager;
+}
+
+void BDDExpr::releaseManager()
+{
+    delete manager;
+    manager = nullptr;
+}
+
+BDDManager::BDDManager() : numVars(0), gcThreshold(InitGCThreshold), numGCs(0)
+{
+    // the two terminals are never collected
+    nodes.push_back({TerminalVar, FalseNode, FalseNode, NullNode, 0});
+    nodes.push_back({TerminalVar, TrueNode, TrueNode, NullNode, 0});
+    buckets.assign(InitBuckets, NullNode);
+    cache.assign(CacheSize, {0, NullNode, NullNode, NullNode});
+}
+
+BDDManager::NodeRef BDDManager::newVar()
+{
+    return mk(numVars++, FalseNode, TrueNode);
+}
+
+BDDManager::NodeRef BDDManager::getLiteral(u32_t var, bool positive)
+{
+    assert(var < numVars && "variable has not been created");
+    return positive ? mk(var, FalseNode, TrueNode) : mk(var, TrueNode, FalseNode);
+}
+
+BDDManager::NodeRef BDDManager::mk(u32_t var, NodeRef low, NodeRef high)
+{
+    // reduction rule: a test whose outcomes coincide is redundant
+    if (low == high)
+        return low;
+
+    u32_t bucket = hashNode(var, low, high);
+    for (NodeRef n = buckets[bucket]; n != NullNode; n = nodes[n].next)
+    {
+        const Node& node = nodes[n];
+        if (node.var == var && node.low == low && node.high == high)
+            return n;
+    }
+
+    NodeRef res;
+    if (!freeNodes.empty())
+    {
+        res = freeNodes.back();
+        freeNodes.pop_back();
+        nodes[res] = {var, low, high, buckets[bucket], 0};
+    }
+    else
+    {
+        res = nodes.size();
+        nodes.push_back({var, low, high, buckets[bucket], 0});
+    }
+    buckets[bucket] = res;
+
+    if (getLiveNodeNum() > 2 * buckets.size())
+        rehash(2 * buckets.size());
+    return res;
+}
+
+void BDDManager::rehash(u32_t numBuckets)
+{
+    buckets.assign(numBuckets, NullNode);
+    std::vector<bool> isFree(nodes.size(), false);
+    for (NodeRef n : freeNodes)
+        isFree[n] = true;
+    for (NodeRef n = TrueNode + 1; n < nodes.size(); ++n)
+    {
+        if (isFree[n])
+            continue;
+        u32_t bucket = hashNode(nodes[n].var, nodes[n].low, nodes[n].high);
+        nodes[n].next = buckets[bucket];
+        buckets[bucket] = n;
+    }
+}
+
+BDDManager::NodeRef BDDManager::AND(NodeRef lhs, NodeRef rhs)
+{
+    assert(lhs != NullNode && rhs != NullNode && "null condition in AND");
+    maybeGC();
+    return apply(OpAnd, lhs, rhs);
+}
+
+BDDManager::NodeRef BDDManager::OR(NodeRef lhs, NodeRef rhs)
+{
+    assert(lhs != NullNode && rhs != NullNode && "null condition in OR");
+    maybeGC();
+    return apply(OpOr, lhs, rhs);
+}
+
+BDDManager::NodeRef BDDManager::NEG(NodeRef node)
+{
+    assert(node != NullNode && "null condition in NEG");
+    maybeGC();
+    return negate(node);
+}
+
+BDDManager::NodeRef BDDManager::apply(u32_t op, NodeRef lhs, NodeRef rhs)
+{
+    // terminal cases
+    if (op == OpAnd)
+    {
+        if (lhs == FalseNode || rhs == FalseNode) return FalseNode;
+        if (lhs == TrueNode) return rhs;
+        if (rhs == TrueNode || lhs == rhs) return lhs;
+    }
+    else
+    {
+        if (lhs == TrueNode || rhs == TrueNode) return TrueNode;
+        if (lhs == FalseNode) return rhs;
+        if (rhs == FalseNode || lhs == rhs) return lhs;
+    }
+    // both operators are commutative; normalise operand order for the cache
+    if (lhs > rhs)
+        std::swap(lhs, rhs);
+
+    CacheEntry& entry = cache[hashOp(op, lhs, rhs)];
+    if (entry.op == op && entry.lhs == lhs && entry.rhs == rhs)
+        return entry.res;
+
+    // Shannon expansion on the smallest top variable; copy fields since mk may grow `nodes`
+    u32_t lVar = nodes[lhs].var, rVar = nodes[rhs].var;
+    u32_t var = std::min(lVar, rVar);
+    NodeRef lLow = lVar == var ? nodes[lhs].low : lhs;
+    NodeRef lHigh = lVar == var ? nodes[lhs].high : lhs;
+    NodeRef rLow = rVar == var ? nodes[rhs].low : rhs;
+    NodeRef rHigh = rVar == var ? nodes[rhs].high : rhs;
+
+    NodeRef low = apply(op, lLow, rLow);
+    NodeRef high = apply(op, lHigh, rHigh);
+    NodeRef res = mk(var, low, high);
+
+    // the cache slot may have been overwritten by the recursive calls
+    cache[hashOp(op, lhs, rhs)] = {op, lhs, rhs, res};
+    return res;
+}
+
+BDDManager::NodeRef BDDManager::negate(NodeRef node)
+{
+    if (node == FalseNode) return TrueNode;
+    if (node == TrueNode) return FalseNode;
+
+    CacheEntry& entry = cache[hashOp(OpNeg, node, node)];
+    if (entry.op == OpNeg && entry.lhs == node)
+        return entry.res;
+
+    u32_t var = nodes[node].var;
+    NodeRef nLow = nodes[node].low, nHigh = nodes[node].high;
+    NodeRef low = negate(nLow);
+    NodeRef high = negate(nHigh);
+    NodeRef res = mk(var, low, high);
+
+    cache[hashOp(OpNeg, node, node)] = {OpNeg, node, node, res};
+    return res;
+}
+
+/*!
+ * Collection only happens on entry to a top-level operation, never during the
+ * recursion, so intermediate results of an operation cannot be reclaimed.
+ */
+void BDDManager::maybeGC()
+{
+    if (getLiveNodeNum() < gcThreshold)
+        return;
+    gc();
+    // grow the threshold when most nodes survived, to avoid collecting on every operation
+    if (getLiveNodeNum() > gcThreshold / 2)
+        gcThreshold *= 2;
+}
+
+void BDDManager::gc()
+{
+    numGCs++;
+    marks.assign(nodes.size(), false);
+    marks[FalseNode] = marks[TrueNode] = true;
+
+    std::vector<NodeRef> worklist;
+    for (NodeRef n = TrueNode + 1; n < nodes.size(); ++n)
+    {
+        if (nodes[n].refs > 0 && !marks[n])
+        {
+            marks[n] = true;
+            worklist.push_back(n);
+        }
+    }
+    while (!worklist.empty())
+    {
+        NodeRef n = worklist.back();
+        worklist.pop_back();
+        for (NodeRef succ : {nodes[n].low, nodes[n].high})
+        {
+            if (!marks[succ])
+            {
+                marks[succ] = true;
+                worklist.push_back(succ);
+            }
+        }
+    }
+
+    // scan downwards so that the lowest free index is handed out first
+    freeNodes.clear();
+    for (NodeRef n = nodes.size() - 1; n > TrueNode; --n)
+    {
+        if (!marks[n])
+        {
+            nodes[n] = {TerminalVar, NullNode, NullNode, NullNode, 0};
+            freeNodes.push_back(n);
+        }
+    }
+
+    rehash(buckets.size());
+    cache.assign(cache.size(), {0, NullNode, NullNode, NullNode});
+}
+
+void BDDManager::getOnePath(NodeRef node, std::vector<std::pair<u32_t, bool>>& path) const
+{
+    assert(node != NullNode && "null condition has no path");
+    while (node > TrueNode)
+    {
+        const Node& n = nodes[node];
+        // every non-terminal node of a reduced BDD reaches true, so any non-false child will do
+        if (n.low != FalseNode)
+        {
+            path.emplace_back(n.var, false);
+            node = n.low;
+        }
+        else
+        {
+            path.emplace_back(n.var, true);
+            node = n.high;
+        }
+    }
+}
+
+std::string BDDManager::dumpStr(NodeRef node) const
+{
+    if (node == NullNode) return "null";
+    if (node == FalseNode) return "false";
+    if (node == TrueNode) return "true";
+
+    const Node& n = nodes[node];
+    std::string var = "c" + std::to_string(n.var);
+    if (n.low == FalseNode && n.high == TrueNode) return var;
+    if (n.low == TrueNode && n.high == FalseNode) return "(not " + var + ")";
+    return "(ite " + var + " " + dumpStr(n.high) + " " + dumpStr(n.low) + ")";
+}
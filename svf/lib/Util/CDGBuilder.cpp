@@ -28,35 +28,19 @@
  */
 #include "Util/CDGBuilder.h"
 #include "Graphs/CallGraph.h"
+#include "Util/Options.h"
+#include <atomic>
+#include <thread>
 
 using namespace SVF;
 using namespace SVFUtil;
 
-void CDGBuilder::dfsNodesBetweenPdomNodes(const SVFBasicBlock *cur,
-        const SVFBasicBlock *tgt,
-        std::vector<const SVFBasicBlock *> &path,
-        std::vector<const SVFBasicBlock *> &tgtNodes,
-        SVFLoopAndDomInfo *ld)
-{
-    path.push_back(cur);
-    if (cur == tgt)
-    {
-        tgtNodes.insert(tgtNodes.end(), path.begin() + 1, path.end());
-    }
-    else
-    {
-        auto it = ld->getPostDomTreeMap().find(cur);
-        for (const auto &nxt: it->second)
-        {
-            dfsNodesBetweenPdomNodes(nxt, tgt, path, tgtNodes, ld);
-        }
-    }
-    path.pop_back();
-}
-
 /*!
  * (3) extract nodes from succ to the least common ancestor LCA of pred and succ
  *     including LCA if LCA is pred, excluding LCA if LCA is not pred
+ *
+ * The nodes are exactly the post-dominator tree path from succ up to LCA, so
+ * walk the immediate post-dominators instead of searching LCA's subtree.
  * @param succ
  * @param LCA
  * @param tgtNodes
@@ -66,9 +50,18 @@ CDGBuilder::extractNodesBetweenPdomNodes(const SVFBasicBlock *succ, const SVFBas
         std::vector<const SVFBasicBlock *> &tgtNodes)
 {
     if (succ == LCA) return;
+    const Map<const SVFBasicBlock *, const SVFBasicBlock *> &pIdom =
+        LCA->getFunction()->getLoopAndDomInfo()->getBB2PIdom();
     std::vector<const SVFBasicBlock *> path;
-    SVFLoopAndDomInfo *ld = const_cast<FunObjVar *>(LCA->getFunction())->getLoopAndDomInfo();
-    dfsNodesBetweenPdomNodes(LCA, succ, path, tgtNodes, ld);
+    for (const SVFBasicBlock *bb = succ; bb != LCA;)
+    {
+        const auto it = pIdom.find(bb);
+        // LCA is not an ancestor of succ: nothing in between
+        if (bb == nullptr || it == pIdom.end()) return;
+        path.push_back(bb);
+        bb = it->second;
+    }
+    tgtNodes.insert(tgtNodes.end(), path.begin(), path.end());
 }
 
 /*!
@@ -118,43 +111,81 @@ s64_t CDGBuilder::getBBSuccessorBranchID(const SVFBasicBlock *BB, const SVFBasic
  *     succ does not post-dominates pred (!postDT->dominates(succ, pred))
  * (3) extract nodes from succ to the least common ancestor LCA of pred and succ
  *     including LCA if LCA is pred, excluding LCA if LCA is not pred
+ *
+ * Functions are independent, so Options::CDGBuildThreads() workers compute
+ * them into per-function buffers which are merged in function order.
  * @param svfgModule
  */
 void CDGBuilder::buildControlDependence()
 {
     const CallGraph* svfirCallGraph = PAG::getPAG()->getCallGraph();
+    std::vector<const FunObjVar *> funs;
     for (const auto& item: *svfirCallGraph)
     {
         const FunObjVar *svfFun = (item.second)->getFunction();
         if (SVFUtil::isExtCall(svfFun)) continue;
-        // extract basic block edges to be processed
-        Map<const SVFBasicBlock *, std::vector<const SVFBasicBlock *>> BBS;
-        extractBBS(svfFun, BBS);
+        funs.push_back(svfFun);
+    }
+
+    std::vector<BBControlDepList> funDeps(funs.size());
+    std::atomic<u32_t> nextFun(0);
+    auto worker = [&]()
+    {
+        for (u32_t i = nextFun++; i < funs.size(); i = nextFun++)
+            buildFunControlDependence(funs[i], funDeps[i]);
+    };
+
+    u32_t numThreads = std::min<u32_t>(std::max<u32_t>(Options::CDGBuildThreads(), 1), funs.size());
+    if (numThreads <= 1)
+        worker();
+    else
+    {
+        std::vector<std::thread> workers;
+        for (u32_t i = 0; i < numThreads; ++i)
+            workers.push_back(std::thread(worker));
+        for (std::thread &w : workers)
+            w.join();
+    }
+
+    for (const BBControlDepList &deps: funDeps)
+    {
+        for (const BBControlDep &dep: deps)
+            updateMap(std::get<0>(dep), std::get<1>(dep), std::get<2>(dep));
+    }
+}
+
+/*!
+ * Control dependences of a single function; only reads the function's CFG,
+ * its post-dominator tree and the ICFG
+ */
+void CDGBuilder::buildFunControlDependence(const FunObjVar *svfFun, BBControlDepList &deps)
+{
+    // extract basic block edges to be processed
+    Map<const SVFBasicBlock *, std::vector<const SVFBasicBlock *>> BBS;
+    extractBBS(svfFun, BBS);
 
-        for (const auto &item: BBS)
+    for (const auto &item: BBS)
+    {
+        const SVFBasicBlock *pred = item.first;
+        // for each bb pair
+        for (const SVFBasicBlock *succ: item.second)
         {
-            const SVFBasicBlock *pred = item.first;
-            // for each bb pair
-            for (const SVFBasicBlock *succ: item.second)
+            const SVFBasicBlock *SVFLCA = svfFun->getLoopAndDomInfo()->findNearestCommonPDominator(pred, succ);
+            std::vector<const SVFBasicBlock *> tgtNodes;
+            // no common ancestor, may be exit()
+            if (SVFLCA == NULL)
+                tgtNodes.push_back(succ);
+            else
             {
-                const SVFBasicBlock *SVFLCA = const_cast<FunObjVar *>(svfFun)->
-                                              getLoopAndDomInfo()->findNearestCommonPDominator(pred, succ);
-                std::vector<const SVFBasicBlock *> tgtNodes;
-                // no common ancestor, may be exit()
-                if (SVFLCA == NULL)
-                    tgtNodes.push_back(succ);
-                else
-                {
-                    if (SVFLCA == pred) tgtNodes.push_back(SVFLCA);
-                    // from succ to LCA
-                    extractNodesBetweenPdomNodes(succ, SVFLCA, tgtNodes);
-                }
+                if (SVFLCA == pred) tgtNodes.push_back(SVFLCA);
+                // from succ to LCA
+                extractNodesBetweenPdomNodes(succ, SVFLCA, tgtNodes);
+            }
 
-                s64_t pos = getBBSuccessorBranchID(pred, succ);
-                for (const SVFBasicBlock *bb: tgtNodes)
-                {
-                    updateMap(pred, bb, pos);
-                }
+            s64_t pos = getBBSuccessorBranchID(pred, succ);
+            for (const SVFBasicBlock *bb: tgtNodes)
+            {
+                deps.emplace_back(pred, bb, pos);
             }
         }
     }
@@ -220,10 +220,50 @@ std::string ExtAPI::getExtBcPath()
 }
 
 
+ExtAPI::ExtFunDesc ExtAPI::compileAnnotations(const std::vector<std::string>& funcAnnotations)
+{
+    static const std::pair<const char*, u32_t> flagNames[] =
+    {
+        {"MEMCPY", EF_MEMCPY}, {"STRCPY", EF_MEMCPY}, {"STRCAT", EF_MEMCPY},
+        {"MEMSET", EF_MEMSET},
+        {"ALLOC_HEAP_RET", EF_ALLOC_HEAP_RET},
+        {"ALLOC_HEAP_ARG", EF_ALLOC_HEAP_ARG},
+        {"ALLOC_STACK_RET", EF_ALLOC_STACK_RET},
+        {"REALLOC_HEAP_RET", EF_REALLOC_HEAP_RET}
+    };
+
+    ExtFunDesc desc;
+    desc.numAnnotations = funcAnnotations.size();
+    for (const std::string& annotation : funcAnnotations)
+    {
+        for (const auto& flagName : flagNames)
+        {
+            if (annotation.find(flagName.first) != std::string::npos)
+                desc.flags |= flagName.second;
+        }
+        // the first ALLOC_HEAP_ARG annotation names the argument, as getExtFuncAnnotation returns the first match
+        if (desc.allocArgPos < 0 && annotation.find("ALLOC_HEAP_ARG") != std::string::npos)
+        {
+            std::string number;
+            for (char c : annotation)
+            {
+                if (isdigit(c))
+                    number.push_back(c);
+            }
+            if (!number.empty())
+                desc.allocArgPos = std::stoi(number);
+        }
+    }
+    if (funcAnnotations.size() == 1 && funcAnnotations.front().find("OVERWRITE") != std::string::npos)
+        desc.flags |= EF_OVERWRITE_ONLY;
+    return desc;
+}
+
 void ExtAPI::setExtFuncAnnotations(const FunObjVar* fun, const std::vector<std::string>& funcAnnotations)
 {
     assert(fun && "Null FunObjVar* pointer");
     funObjVar2Annotations[fun] = funcAnnotations;
+    funObjVar2Desc[fun] = compileAnnotations(funcAnnotations);
 }
 
 bool ExtAPI::hasExtFuncAnnotation(const FunObjVar *fun, const std::string &funcAnnotation)
@@ -264,60 +304,52 @@ const std::vector<std::string>& ExtAPI::getExtFuncAnnotations(const FunObjVar* f
 
 bool ExtAPI::is_memcpy(const FunObjVar *F)
 {
-    return F &&
-           (hasExtFuncAnnotation(F, "MEMCPY") ||  hasExtFuncAnnotation(F, "STRCPY")
-            || hasExtFuncAnnotation(F, "STRCAT"));
+    return hasExtFunFlag(F, EF_MEMCPY);
 }
 
 bool ExtAPI::is_memset(const FunObjVar *F)
 {
-    return F && hasExtFuncAnnotation(F, "MEMSET");
+    return hasExtFunFlag(F, EF_MEMSET);
 }
 
 bool ExtAPI::is_alloc(const FunObjVar* F)
 {
-    return F && hasExtFuncAnnotation(F, "ALLOC_HEAP_RET");
+    return hasExtFunFlag(F, EF_ALLOC_HEAP_RET);
 }
 
 // Does (F) allocate a new object and assign it to one of its arguments?
 bool ExtAPI::is_arg_alloc(const FunObjVar* F)
 {
-    return F && hasExtFuncAnnotation(F, "ALLOC_HEAP_ARG");
+    return hasExtFunFlag(F, EF_ALLOC_HEAP_ARG);
 }
 
 bool ExtAPI::is_alloc_stack_ret(const FunObjVar* F)
 {
-    return F && hasExtFuncAnnotation(F, "ALLOC_STACK_RET");
+    return hasExtFunFlag(F, EF_ALLOC_STACK_RET);
 }
 
 // Get the position of argument which holds the new object
 s32_t ExtAPI::get_alloc_arg_pos(const FunObjVar* F)
 {
-    std::string allocArg = getExtFuncAnnotation(F, "ALLOC_HEAP_ARG");
-    assert(!allocArg.empty() && "Not an alloc call via argument or incorrect extern function annotation!");
-
-    std::string number;
-    for (char c : allocArg)
-    {
-        if (isdigit(c))
-            number.push_back(c);
-    }
-    assert(!number.empty() && "Incorrect naming convention for svf external functions(ALLOC_HEAP_ARG + number)?");
-    return std::stoi(number);
+    const ExtFunDesc& desc = getExtFunDesc(F);
+    assert((desc.flags & EF_ALLOC_HEAP_ARG) && "Not an alloc call via argument or incorrect extern function annotation!");
+    assert(desc.allocArgPos >= 0 && "Incorrect naming convention for svf external functions(ALLOC_HEAP_ARG + number)?");
+    return desc.allocArgPos;
 }
 
 // Does (F) reallocate a new object?
 bool ExtAPI::is_realloc(const FunObjVar* F)
 {
-    return F && hasExtFuncAnnotation(F, "REALLOC_HEAP_RET");
+    return hasExtFunFlag(F, EF_REALLOC_HEAP_RET);
 }
 bool ExtAPI::is_ext(const FunObjVar *F)
 {
     assert(F && "Null FunObjVar* pointer");
     if (F->isDeclaration() || F->isIntrinsic())
         return true;
-    else if (hasExtFuncAnnotation(F, "OVERWRITE") && getExtFuncAnnotations(F).size() == 1)
+    const ExtFunDesc& desc = getExtFunDesc(F);
+    if (desc.flags & EF_OVERWRITE_ONLY)
         return false;
     else
-        return !getExtFuncAnnotations(F).empty();
+        return desc.numAnnotations != 0;
 }
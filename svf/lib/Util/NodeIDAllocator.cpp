@@ -4,6 +4,7 @@
 #include <iostream>
 #include <queue>
 #include <cmath>
+#include <array>
 
 #include "FastCluster/fastcluster.h"
 #include "MemoryModel/PointerAnalysisImpl.h"
@@ -176,6 +177,7 @@ const std::string NodeIDAllocator::Clusterer::NumObjects = "NumObjects";
 const std::string NodeIDAllocator::Clusterer::RegioningTime = "RegioningTime";
 const std::string NodeIDAllocator::Clusterer::DistanceMatrixTime = "DistanceMatrixTime";
 const std::string NodeIDAllocator::Clusterer::FastClusterTime = "FastClusterTime";
+const std::string NodeIDAllocator::Clusterer::MinHashTime = "MinHashTime";
 const std::string NodeIDAllocator::Clusterer::DendrogramTraversalTime = "DendrogramTravTime";
 const std::string NodeIDAllocator::Clusterer::EvalTime = "EvalTime";
 const std::string NodeIDAllocator::Clusterer::TotalTime = "TotalTime";
@@ -197,6 +199,7 @@ std::vector<NodeID> NodeIDAllocator::Clusterer::cluster(BVDataPTAImpl *pta, cons
 
     Map<std::string, std::string> overallStats;
     double fastClusterTime = 0.0;
+    double minHashTime = 0.0;
     double distanceMatrixTime = 0.0;
     double dendrogramTraversalTime = 0.0;
     double regioningTime = 0.0;
@@ -317,6 +320,7 @@ std::vector<NodeID> NodeIDAllocator::Clusterer::cluster(BVDataPTAImpl *pta, cons
         methods.push_back(HCLUST_METHOD_SINGLE);
         methods.push_back(HCLUST_METHOD_COMPLETE);
         methods.push_back(HCLUST_METHOD_AVERAGE);
+        methods.push_back(HCLUST_METHOD_SVF_MINHASH);
     }
     else
     {
@@ -355,6 +359,16 @@ std::vector<NodeID> NodeIDAllocator::Clusterer::cluster(BVDataPTAImpl *pta, cons
             ++numGtIntRegions;
             nonTrivialRegionObjects += regionNumObjects;
 
+            if (method == HCLUST_METHOD_SVF_MINHASH)
+            {
+                clkStart = PTAStat::getClk(true);
+                minHashOrder(regionsPointsTos[region], regionNumObjects, regionReverseMappings[region],
+                             regionMappings[region], nodeMap, allocCounter);
+                clkEnd = PTAStat::getClk(true);
+                minHashTime += (clkEnd - clkStart) / TIMEINTERVAL;
+                continue;
+            }
+
             double *distMatrix = getDistanceMatrix(regionsPointsTos[region], regionNumObjects,
                                                    regionReverseMappings[region], distanceMatrixTime);
 
@@ -391,8 +405,9 @@ std::vector<NodeID> NodeIDAllocator::Clusterer::cluster(BVDataPTAImpl *pta, cons
     overallStats[DistanceMatrixTime] = std::to_string(distanceMatrixTime);
     overallStats[DendrogramTraversalTime] = std::to_string(dendrogramTraversalTime);
     overallStats[FastClusterTime] = std::to_string(fastClusterTime);
+    overallStats[MinHashTime] = std::to_string(minHashTime);
     overallStats[EvalTime] = std::to_string(evalTime);
-    overallStats[TotalTime] = std::to_string(distanceMatrixTime + dendrogramTraversalTime + fastClusterTime + regioningTime + evalTime);
+    overallStats[TotalTime] = std::to_string(distanceMatrixTime + dendrogramTraversalTime + fastClusterTime + minHashTime + regioningTime + evalTime);
 
     overallStats[BestCandidate] = SVFUtil::hclustMethodToString(bestMapping.first);
     printStats(evalSubtitle + ": overall", overallStats);
@@ -504,6 +519,65 @@ double *NodeIDAllocator::Clusterer::getDistanceMatrix(const std::vector<std::pai
     return distMatrix;
 }
 
+void NodeIDAllocator::Clusterer::minHashOrder(const std::vector<std::pair<const PointsTo *, unsigned>> &pointsToSets,
+        const size_t numObjects, const Map<NodeID, unsigned> &nodeMap,
+        const std::vector<NodeID> &regionNodeMap, std::vector<NodeID> &newNodeMap,
+        unsigned &allocCounter)
+{
+    // Signature length; ties on the first components are broken by the later ones.
+    static const unsigned numHashes = 4;
+
+    // splitmix64 finaliser to derive independent hashes from the points-to set hash.
+    auto mix = [](u64_t x)
+    {
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    };
+
+    // Objects in no points-to set get infinite signatures and go last.
+    std::vector<std::array<double, numHashes>> signatures(numObjects);
+    for (std::array<double, numHashes> &signature : signatures)
+        signature.fill(std::numeric_limits<double>::infinity());
+
+    for (const std::pair<const PointsTo *, unsigned> &ptsOcc : pointsToSets)
+    {
+        const PointsTo *pts = ptsOcc.first;
+        assert(pts != nullptr);
+        // Like the distance matrix, favour sets which occur often and need few words.
+        const double weight = (double) ptsOcc.second / (requiredBits(*pts) / NATIVE_INT_SIZE);
+        const u64_t ptsHash = std::hash<PointsTo>()(*pts);
+
+        // Weighted MinHash: an exponential variate with rate weight per (set, hash function), so
+        // two objects share a minimum with probability close to their weighted Jaccard similarity.
+        std::array<double, numHashes> keys;
+        for (unsigned h = 0; h < numHashes; ++h)
+        {
+            const double u = ((mix(ptsHash + h) >> 11) + 1) * (1.0 / 9007199254740992.0);
+            keys[h] = -std::log(u) / weight;
+        }
+
+        for (const NodeID o : *pts)
+        {
+            const Map<NodeID, unsigned>::const_iterator mo = nodeMap.find(o);
+            assert(mo != nodeMap.end());
+            std::array<double, numHashes> &signature = signatures[mo->second];
+            for (unsigned h = 0; h < numHashes; ++h)
+                signature[h] = std::min(signature[h], keys[h]);
+        }
+    }
+
+    std::vector<unsigned> order(numObjects);
+    for (unsigned i = 0; i < numObjects; ++i) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&signatures](unsigned a, unsigned b)
+    {
+        return signatures[a] < signatures[b];
+    });
+
+    for (const unsigned i : order) newNodeMap[regionNodeMap[i]] = allocCounter++;
+}
+
 void NodeIDAllocator::Clusterer::traverseDendrogram(std::vector<NodeID> &nodeMap, const int *dendrogram, const size_t numObjects, unsigned &allocCounter, Set<int> &visited, const int index, const std::vector<NodeID> &regionNodeMap)
 {
     if (visited.find(index) != visited.end()) return;
@@ -701,7 +775,7 @@ void NodeIDAllocator::Clusterer::printStats(std::string subtitle, Map<std::strin
         NumObjects, TheoreticalNumWords, OriginalSbvNumWords, OriginalBvNumWords,
         NewSbvNumWords, NewBvNumWords, NumRegions, NumGtIntRegions,
         NumNonTrivialRegionObjects, LargestRegion, RegioningTime,
-        DistanceMatrixTime, FastClusterTime, DendrogramTraversalTime,
+        DistanceMatrixTime, FastClusterTime, MinHashTime, DendrogramTraversalTime,
         EvalTime, TotalTime, BestCandidate
     };
 
@@ -368,7 +368,8 @@ const OptionMap<u32_t> Options::ClusterMethod(
     {HCLUST_METHOD_SINGLE,     "single", "single linkage; minimum spanning tree algorithm"},
     {HCLUST_METHOD_COMPLETE, "complete", "complete linkage; nearest-neighbour-chain algorithm"},
     {HCLUST_METHOD_AVERAGE,   "average", "unweighted average linkage; nearest-neighbour-chain algorithm"},
-    {HCLUST_METHOD_SVF_BEST,     "best", "try all linkage criteria; choose best"},
+    {HCLUST_METHOD_SVF_MINHASH, "minhash", "weighted MinHash ordering; near-linear, for very large regions"},
+    {HCLUST_METHOD_SVF_BEST,     "best", "try all linkage criteria and minhash; choose best"},
 }
 );
 
@@ -449,6 +450,30 @@ const Option<std::string> Options::ReadSVFG(
     ""
 );
 
+const Option<bool> Options::SVFGBinaryFormat(
+    "svfg-binary",
+    "Write SVFG with -write-svfg in the compact binary format (-read-svfg detects the format)",
+    false
+);
+
+const Option<bool> Options::SVFGOnDemand(
+    "svfg-on-demand",
+    "Build memory SSA and indirect SVFG nodes/edges of a function only when a client first traverses into it",
+    false
+);
+
+const Option<u32_t> Options::SVFGOnDemandMaxFuns(
+    "svfg-on-demand-max-funs",
+    "Build the rest of the SVFG eagerly once this many functions are materialized on demand (0: no limit)",
+    0
+);
+
+const Option<u32_t> Options::SVFGEdgeThreads(
+    "svfg-edge-threads",
+    "number of threads computing the indirect SVFG edges of functions",
+    1
+);
+
 
 const Option<bool> Options::IntraLock(
     "intra-lock-td-edge",
@@ -546,6 +571,32 @@ Option<bool> Options::SVFMain(
     false
 );
 
+const Option<u32_t> Options::ModuleLoadThreads(
+    "module-load-threads",
+    "number of threads used to read bitcode files before they are parsed",
+    1
+);
+
+const Option<std::string> Options::ObjTypeCache(
+    "objtype-cache",
+    "file caching inferred object types across runs on the same input modules",
+    ""
+);
+
+// SVFIRBuilder.cpp
+const Option<u32_t> Options::SVFIRBuildThreads(
+    "svfir-build-threads",
+    "number of threads computing per-function dominance information and recording function-local SVFStmts when building SVFIR",
+    1
+);
+
+// CDGBuilder.cpp
+const Option<u32_t> Options::CDGBuildThreads(
+    "cdg-build-threads",
+    "number of threads computing per-function control dependence when building the CDG",
+    1
+);
+
 Option<bool> Options::ModelConsts(
     "model-consts",
     "Modeling individual constant objects",
@@ -593,6 +644,12 @@ const Option<bool> Options::PrintPathCond(
     false
 );
 
+const Option<bool> Options::SaberBDD(
+    "saber-bdd",
+    "Use the built-in ROBDD package instead of Z3 for path conditions",
+    false
+);
+
 
 // SaberSVFGBuilder.cpp
 const Option<bool> Options::CollectExtRetGlobals(
@@ -653,6 +710,18 @@ Option<bool> Options::DetectPWC(
     true
 );
 
+const Option<bool> Options::CompactConsCG(
+    "compact-cg",
+    "Merge SCCs of Andersen's constraint graph without moving its edges (nander and ander only)",
+    false
+);
+
+const Option<u32_t> Options::HeapCloneBudget(
+    "heap-clone-budget",
+    "Maximum number of call sites of allocator wrappers given their own clone of the wrapped heap object, for -ander and -nander without -svfg (0: no cloning)",
+    0
+);
+
 //SVFIRBuilder.cpp
 const Option<bool> Options::VtableInSVFIR(
     "vt-in-ir",
@@ -660,6 +729,13 @@ const Option<bool> Options::VtableInSVFIR(
     false
 );
 
+// Steensgaard.cpp
+const Option<u32_t> Options::SteensThreads(
+    "steens-threads",
+    "number of threads reading constraint edges into Steensgaard's flat edge arrays",
+    1
+);
+
 //WPAPass.cpp
 const Option<std::string> Options::ExtAPIPath(
     "extapi",
@@ -691,6 +767,8 @@ OptionMultiple<PointerAnalysis::PTATY> Options::PASelected(
     {PointerAnalysis::Andersen_WPA, "nander", "Standard inclusion-based analysis"},
     {PointerAnalysis::AndersenSCD_WPA, "sander", "Selective cycle detection inclusion-based analysis"},
     {PointerAnalysis::AndersenSFR_WPA, "sfrander", "Stride-based field representation inclusion-based analysis"},
+    {PointerAnalysis::AndersenHCD_WPA, "hander", "Hybrid cycle detection inclusion-based analysis"},
+    {PointerAnalysis::AndersenLCD_WPA, "lander", "Lazy and hybrid cycle detection inclusion-based analysis"},
     {PointerAnalysis::AndersenWaveDiff_WPA, "ander", "Diff wave propagation inclusion-based analysis"},
     {PointerAnalysis::Steensgaard_WPA, "steens", "Steensgaard's pointer analysis"},
     // Disabled till further work is done.
@@ -813,6 +891,27 @@ const OptionMap<u32_t> Options::AEFunEntry(
         "Analyze from every no-external-caller SCC after Andersen resolves the call graph."
     }
 });
+const Option<u32_t> Options::WTOThreads(
+    "wto-threads",
+    "number of threads building the weak topological orders of independent call graph SCCs",
+    1
+);
+const Option<std::string> Options::WTOCache(
+    "wto-cache",
+    "file caching the weak topological orders across runs on the same ICFG",
+    ""
+);
+
+const Option<std::string> Options::AEDefUseIndex(
+    "ae-defuse-index",
+    "file keeping the full-sparse def-use index across runs on the same SVFIR",
+    ""
+);
+const Option<bool> Options::AEReleaseTrace(
+    "ae-release-trace",
+    "release the abstract states of finished WTO components that later analysis does not read (dense and semi-sparse)",
+    false
+);
 const Option<u32_t> Options::WidenDelay(
     "widen-delay", "Loop Widen Delay", 3);
 const OptionMap<u32_t> Options::HandleRecur(
@@ -35,6 +35,8 @@ using namespace SVF;
 using namespace std;
 
 double SVFStat::timeOfBuildingLLVMModule = 0;
+double SVFStat::timeOfLoadingLLVMModules = 0;
+double SVFStat::timeOfLLVMPrePasses = 0;
 double SVFStat::timeOfBuildingSVFIR = 0;
 double SVFStat::timeOfBuildingSymbolTable = 0;
 bool SVFStat::printGeneralStats = true;
@@ -207,6 +209,8 @@ void SVFStat::performStat()
     generalNumMap["TotalCallSite"] = pag->getCallSiteSet().size();
 
     timeStatMap["LLVMIRTime"] = SVFStat::timeOfBuildingLLVMModule;
+    timeStatMap["LLVMLoadTime"] = SVFStat::timeOfLoadingLLVMModules;
+    timeStatMap["LLVMPrePassTime"] = SVFStat::timeOfLLVMPrePasses;
     timeStatMap["SymbolTableTime"] = SVFStat::timeOfBuildingSymbolTable;
     timeStatMap["SVFIRTime"] = SVFStat::timeOfBuildingSVFIR;
 
@@ -174,16 +174,16 @@ void SVFUtil::reportMemoryUsageKB(const std::string& infor, OutStream & O)
 }
 
 /*!
- * Get memory usage
+ * Get memory usage, and the peak resident set size if vmhwm_kb is given
  */
-bool SVFUtil::getMemoryUsageKB(u32_t* vmrss_kb, u32_t* vmsize_kb)
+bool SVFUtil::getMemoryUsageKB(u32_t* vmrss_kb, u32_t* vmsize_kb, u32_t* vmhwm_kb)
 {
     /* Get the current process' status file from the proc filesystem */
-    char buffer[8192];
+    char buffer[8192] = {0};
     FILE* procfile = fopen("/proc/self/status", "r");
     if(procfile)
     {
-        u32_t result = fread(buffer, sizeof(char), 8192, procfile);
+        u32_t result = fread(buffer, sizeof(char), sizeof(buffer) - 1, procfile);
         if (result == 0)
         {
             fputs ("Reading error\n",stderr);
@@ -191,7 +191,7 @@ bool SVFUtil::getMemoryUsageKB(u32_t* vmrss_kb, u32_t* vmsize_kb)
     }
     else
     {
-        SVFUtil::writeWrnMsg(" /proc/self/status file not exit!");
+        SVFUtil::writeWrnMsg(" /proc/self/status file does not exist!");
         return false;
     }
     fclose(procfile);
@@ -202,8 +202,9 @@ bool SVFUtil::getMemoryUsageKB(u32_t* vmrss_kb, u32_t* vmsize_kb)
 
     bool found_vmrss = false;
     bool found_vmsize = false;
+    bool found_vmhwm = vmhwm_kb == nullptr;
 
-    while (line != nullptr && (found_vmrss == false || found_vmsize == false))
+    while (line != nullptr && (found_vmrss == false || found_vmsize == false || found_vmhwm == false))
     {
         if (strstr(line, "VmRSS:") != nullptr)
         {
@@ -217,10 +218,16 @@ bool SVFUtil::getMemoryUsageKB(u32_t* vmrss_kb, u32_t* vmsize_kb)
             found_vmsize = true;
         }
 
+        if (vmhwm_kb && strstr(line, "VmHWM:") != nullptr)
+        {
+            sscanf(line, "%*s %u", vmhwm_kb);
+            found_vmhwm = true;
+        }
+
         line = strtok(nullptr, delims);
     }
 
-    return (found_vmrss && found_vmsize);
+    return (found_vmrss && found_vmsize && found_vmhwm);
 }
 
 /*!
@@ -259,6 +266,8 @@ std::string SVFUtil::hclustMethodToString(hclust_fast_methods method)
         return "median";
     case HCLUST_METHOD_SVF_BEST:
         return "svf-best";
+    case HCLUST_METHOD_SVF_MINHASH:
+        return "minhash";
     default:
         assert(false && "SVFUtil::hclustMethodToString: unknown method");
         abort();
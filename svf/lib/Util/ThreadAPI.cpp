@@ -133,13 +133,18 @@ void ThreadAPI::init()
 /// Get the function type if it is a threadAPI function
 ThreadAPI::TD_TYPE ThreadAPI::getType(const FunObjVar* F) const
 {
-    if(F)
-    {
-        TDAPIMap::const_iterator it= tdAPIMap.find(F->getName());
-        if(it != tdAPIMap.end())
-            return it->second;
-    }
-    return TD_DUMMY;
+    if(F == nullptr)
+        return TD_DUMMY;
+    auto cached = funToTypeMap.find(F);
+    if(cached != funToTypeMap.end())
+        return cached->second;
+
+    TD_TYPE type = TD_DUMMY;
+    TDAPIMap::const_iterator it= tdAPIMap.find(F->getName());
+    if(it != tdAPIMap.end())
+        type = it->second;
+    funToTypeMap[F] = type;
+    return type;
 }
 
 bool ThreadAPI::isTDFork(const CallICFGNode *inst) const
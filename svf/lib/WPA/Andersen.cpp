@@ -46,6 +46,7 @@ u32_t AndersenBase::numOfProcessedLoad = 0;
 u32_t AndersenBase::numOfProcessedStore = 0;
 u32_t AndersenBase::numOfSfrs = 0;
 u32_t AndersenBase::numOfFieldExpand = 0;
+u32_t AndersenBase::numOfHeapClones = 0;
 
 u32_t AndersenBase::numOfSCCDetection = 0;
 double AndersenBase::timeOfSCCDetection = 0;
@@ -79,6 +80,8 @@ void AndersenBase::initialize()
     /// Build Constraint Graph
     consCG = new ConstraintGraph(pag);
     setGraph(consCG);
+    if (heapCloning && Options::HeapCloneBudget() > 0)
+        cloneWrappedHeapObjs();
     if (Options::ConsCGDotGraph())
         consCG->dump("consCG_initial");
 }
@@ -364,6 +367,100 @@ void AndersenBase::connectCaller2CalleeParams(const CallICFGNode* cs,
     }
 }
 
+/*!
+ * A function is an allocator wrapper if its return var only receives the
+ * address of a heap object through a chain of copies, and nothing else in
+ * the function uses the object (e.g., p = malloc(n); return p;). The copy from
+ * the return var to the return of a direct call site is then replaced by the
+ * address of a clone of the object, which is sound as no other pointer can
+ * reach the object. Indirect call sites, connected during solving, keep
+ * sharing the object.
+ *
+ * The clones are only in the constraint graph, not in the statements of the
+ * SVFIR, so analyses that rebuild points-to sets from the SVFIR or an SVFG
+ * (flow-sensitive, DDA, SVFG clients) would not see them. Cloning is therefore
+ * only run when the creator of this analysis enables it with setHeapCloning.
+ */
+void AndersenBase::cloneWrappedHeapObjs()
+{
+    /// return vars of functions in id order, so the budget goes to the same call sites in every run
+    OrderedMap<NodeID, std::vector<const RetPE*>> retVarToRets;
+    for (const SVFStmt* stmt : pag->getSVFStmtSet(SVFStmt::Ret))
+    {
+        const RetPE* ret = SVFUtil::cast<RetPE>(stmt);
+        retVarToRets[ret->getRHSVarID()].push_back(ret);
+    }
+
+    u32_t budget = Options::HeapCloneBudget();
+    for (const auto& it : retVarToRets)
+    {
+        NodeBS csRets;
+        for (const RetPE* ret : it.second)
+            csRets.set(ret->getLHSVarID());
+        const HeapObjVar* obj = getWrappedHeapObj(it.first, csRets);
+        if (obj == nullptr)
+            continue;
+
+        for (const RetPE* ret : it.second)
+        {
+            if (budget == 0)
+                return;
+            if (ret->getCallSite()->isIndirectCall())
+                continue;
+
+            ConstraintEdge* retCopy = nullptr;
+            for (ConstraintEdge* edge : consCG->getConstraintNode(it.first)->getCopyOutEdges())
+            {
+                if (edge->getDstID() == ret->getLHSVarID())
+                    retCopy = edge;
+            }
+            if (retCopy == nullptr)
+                continue;
+
+            consCG->removeDirectEdge(retCopy);
+            NodeID clone = pag->getHeapObjClone(obj, ret->getCallSite());
+            if (!consCG->hasConstraintNode(clone))
+                consCG->addConstraintNode(new ConstraintNode(clone), clone);
+            consCG->addAddrCGEdge(clone, ret->getLHSVarID());
+            numOfHeapClones++;
+            budget--;
+        }
+    }
+}
+
+/*!
+ * Walk back from retVar through copies, each of which must be the only
+ * in-edge of its dst and the only out-edge of its src, to the address of a
+ * heap object. retVar itself may only flow to the call site returns.
+ */
+const HeapObjVar* AndersenBase::getWrappedHeapObj(NodeID retVar, const NodeBS& csRets) const
+{
+    if (!consCG->hasConstraintNode(retVar))
+        return nullptr;
+
+    ConstraintNode* node = consCG->getConstraintNode(retVar);
+    for (const ConstraintEdge* edge : node->getOutEdges())
+    {
+        if (!SVFUtil::isa<CopyCGEdge>(edge) || !csRets.test(edge->getDstID()))
+            return nullptr;
+    }
+
+    NodeBS visited;
+    while (visited.test_and_set(node->getId()) && node->getInEdges().size() == 1)
+    {
+        ConstraintEdge* edge = *node->getInEdges().begin();
+        ConstraintNode* src = edge->getSrcNode();
+        if (src->getOutEdges().size() != 1)
+            return nullptr;
+        if (SVFUtil::isa<AddrCGEdge>(edge))
+            return SVFUtil::dyn_cast<HeapObjVar>(pag->getGNode(src->getId()));
+        if (!SVFUtil::isa<CopyCGEdge>(edge))
+            return nullptr;
+        node = src;
+    }
+    return nullptr;
+}
+
 void AndersenBase::heapAllocatorViaIndCall(const CallICFGNode* cs, NodePairSet &cpySrcNodes)
 {
     assert(cs->getCalledFunction() == nullptr && "not an indirect callsite?");
@@ -422,6 +519,11 @@ void Andersen::initialize()
 
     if (Options::ClusterAnder()) cluster();
 
+    delete adjacency;
+    adjacency = nullptr;
+    if (Options::CompactConsCG() && (getAnalysisTy() == Andersen_WPA || getAnalysisTy() == AndersenWaveDiff_WPA))
+        adjacency = new ConstraintAdjacency(consCG);
+
     /// Initialize worklist
     processAllAddr();
 }
@@ -443,6 +545,17 @@ void Andersen::finalize()
         NodeIDAllocator::Clusterer::printStats("post-main", stats);
     }
 
+    /// Merged nodes and their edges are left in the graph during solving,
+    /// move them now as the clients of the constraint graph expect
+    if (adjacency)
+    {
+        double mergeStart = stat->getClk();
+        adjacency->materialize();
+        delete adjacency;
+        adjacency = nullptr;
+        timeOfSCCMerges += (stat->getClk() - mergeStart) / TIMEINTERVAL;
+    }
+
     /// sanitize field insensitive obj
     /// TODO: Fields has been collapsed during Andersen::collapseField().
     //	sanitizePts();
@@ -478,7 +591,18 @@ void Andersen::handleCopyGep(ConstraintNode* node)
     NodeID nodeId = node->getId();
     computeDiffPts(nodeId);
 
-    if (!getDiffPts(nodeId).empty())
+    if (!getDiffPts(nodeId).empty() && adjacency)
+    {
+        for (NodeID dst : adjacency->getCopyOutNodes(nodeId))
+        {
+            numOfProcessedCopy++;
+            if (unionPts(dst, getDiffPts(nodeId)))
+                pushIntoWorklist(dst);
+        }
+        for (ConstraintEdge* edge : adjacency->getGepOutEdges(nodeId))
+            processGep(nodeId, SVFUtil::cast<GepCGEdge>(edge));
+    }
+    else if (!getDiffPts(nodeId).empty())
     {
         for (ConstraintEdge* edge : node->getCopyOutEdges())
             processCopy(nodeId, edge);
@@ -496,6 +620,23 @@ void Andersen::handleCopyGep(ConstraintNode* node)
 void Andersen::handleLoadStore(ConstraintNode *node)
 {
     NodeID nodeId = node->getId();
+    if (adjacency)
+    {
+        for (NodeID ptd : getPts(nodeId))
+        {
+            for (const ConstraintEdge* load : adjacency->getLoadOutEdges(nodeId))
+            {
+                if (processLoad(ptd, load))
+                    pushIntoWorklist(ptd);
+            }
+            for (const ConstraintEdge* store : adjacency->getStoreInEdges(nodeId))
+            {
+                if (processStore(ptd, store))
+                    pushIntoWorklist(store->getSrcID());
+            }
+        }
+        return;
+    }
     for (PointsTo::iterator piter = getPts(nodeId).begin(), epiter =
                 getPts(nodeId).end(); piter != epiter; ++piter)
     {
@@ -556,12 +697,12 @@ bool Andersen::processLoad(NodeID node, const ConstraintEdge* load)
     ///       make gcc in spec 2000 pass the flow-sensitive analysis.
     ///       Try to handle black hole obj in an appropriate way.
 //	if (pag->isBlkObjOrConstantObj(node))
-    if (pag->isConstantObj(node) || pag->getSVFVar(load->getDstID())->isPointer() == false)
+    NodeID dst = sccRepNode(load->getDstID());
+    if (pag->isConstantObj(node) || pag->getSVFVar(dst)->isPointer() == false)
         return false;
 
     numOfProcessedLoad++;
 
-    NodeID dst = load->getDstID();
     return addCopyEdge(node, dst);
 }
 
@@ -576,12 +717,12 @@ bool Andersen::processStore(NodeID node, const ConstraintEdge* store)
     ///       make gcc in spec 2000 pass the flow-sensitive analysis.
     ///       Try to handle black hole obj in an appropriate way
 //	if (pag->isBlkObjOrConstantObj(node))
-    if (pag->isConstantObj(node) || pag->getSVFVar(store->getSrcID())->isPointer() == false)
+    NodeID src = sccRepNode(store->getSrcID());
+    if (pag->isConstantObj(node) || pag->getSVFVar(src)->isPointer() == false)
         return false;
 
     numOfProcessedStore++;
 
-    NodeID src = store->getSrcID();
     return addCopyEdge(src, node);
 }
 
@@ -709,13 +850,13 @@ inline void Andersen::collapseFields()
  */
 void Andersen::mergeSccCycle()
 {
-    NodeStack topoOrder = getSCCDetector()->topoNodeStack();
+    NodeStack topoOrder = adjacency ? adjacency->topoNodeStack() : getSCCDetector()->topoNodeStack();
 
     while (!topoOrder.empty())
     {
         NodeID repNodeId = topoOrder.top();
         topoOrder.pop();
-        const NodeBS& subNodes = getSCCDetector()->subNodes(repNodeId);
+        const NodeBS& subNodes = adjacency ? adjacency->subNodes(repNodeId) : getSCCDetector()->subNodes(repNodeId);
         // merge sub nodes to rep node
         mergeSccNodes(repNodeId, subNodes);
     }
@@ -827,7 +968,10 @@ NodeStack& Andersen::SCCDetect()
     numOfSCCDetection++;
 
     double sccStart = stat->getClk();
-    WPAConstraintSolver::SCCDetect();
+    if (adjacency)
+        adjacency->detectSCCs();
+    else
+        WPAConstraintSolver::SCCDetect();
     double sccEnd = stat->getClk();
 
     timeOfSCCDetection +=  (sccEnd - sccStart)/TIMEINTERVAL;
@@ -840,7 +984,7 @@ NodeStack& Andersen::SCCDetect()
 
     timeOfSCCMerges +=  (mergeEnd - mergeStart)/TIMEINTERVAL;
 
-    return getSCCDetector()->topoNodeStack();
+    return adjacency ? adjacency->topoNodeStack() : getSCCDetector()->topoNodeStack();
 }
 
 /*!
@@ -856,6 +1000,14 @@ bool Andersen::mergeSrcToTgt(NodeID nodeId, NodeID newRepId)
     updatePropaPts(newRepId, nodeId);
     unionPts(newRepId,nodeId);
 
+    /// only append the adjacency of node to rep, the graph is updated in finalize()
+    if (adjacency)
+    {
+        bool pwc = adjacency->mergeNode(nodeId, newRepId) || consCG->isPWCNode(nodeId);
+        updateNodeRepAndSubs(nodeId, newRepId);
+        return pwc;
+    }
+
     /// move the edges from node to rep, and remove the node
     ConstraintNode* node = consCG->getConstraintNode(nodeId);
     bool pwc = consCG->moveEdgesToRepNode(node, consCG->getConstraintNode(newRepId));
@@ -0,0 +1,232 @@
+//===- AndersenHCD.cpp -- Hybrid cycle detection based Andersen's analysis---//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * AndersenHCD.cpp
+ */
+
+#include "WPA/AndersenHCD.h"
+
+using namespace SVF;
+using namespace SVFUtil;
+using namespace std;
+
+/*!
+ * Run the offline pass once the constraint graph is built
+ */
+void AndersenHCD::initialize()
+{
+    Andersen::initialize();
+    hcdTargets.clear();
+    detectOfflineCycles();
+}
+
+/*!
+ * Tarjan's algorithm over the constraint graph with ref nodes. The ref node
+ * of n is n + refBase; gep edges are left out as merging through them would
+ * lose field-sensitivity.
+ */
+void AndersenHCD::detectOfflineCycles()
+{
+    double sccStart = stat->getClk();
+
+    NodeID refBase = 0;
+    for (ConstraintGraph::iterator it = consCG->begin(), eit = consCG->end(); it != eit; ++it)
+        refBase = std::max(refBase, it->first + 1);
+
+    Map<NodeID, std::vector<NodeID>> succs;
+    for (ConstraintGraph::iterator it = consCG->begin(), eit = consCG->end(); it != eit; ++it)
+    {
+        NodeID id = it->first;
+        const ConstraintNode* node = it->second;
+        for (const ConstraintEdge* copy : node->getCopyOutEdges())
+            succs[id].push_back(copy->getDstID());
+        for (const ConstraintEdge* load : node->getLoadOutEdges())
+            succs[id + refBase].push_back(load->getDstID());
+        for (const ConstraintEdge* store : node->getStoreInEdges())
+            succs[store->getSrcID()].push_back(id + refBase);
+    }
+
+    struct Frame
+    {
+        NodeID node;
+        u32_t next;
+    };
+    Map<NodeID, u32_t> dfsNum;
+    Map<NodeID, u32_t> lowLink;
+    Set<NodeID> onStack;
+    std::vector<NodeID> sccStack;
+    std::vector<Frame> frames;
+    std::vector<std::vector<NodeID>> cycles;
+    u32_t index = 0;
+    const std::vector<NodeID> noSuccs;
+
+    auto visit = [&](NodeID id)
+    {
+        dfsNum[id] = lowLink[id] = ++index;
+        sccStack.push_back(id);
+        onStack.insert(id);
+        frames.push_back(Frame{id, 0});
+    };
+    auto getSuccs = [&](NodeID id) -> const std::vector<NodeID>&
+    {
+        auto it = succs.find(id);
+        return it == succs.end() ? noSuccs : it->second;
+    };
+
+    for (const auto& root : succs)
+    {
+        if (dfsNum.count(root.first))
+            continue;
+        visit(root.first);
+        while (!frames.empty())
+        {
+            NodeID node = frames.back().node;
+            const std::vector<NodeID>& nodeSuccs = getSuccs(node);
+            if (frames.back().next < nodeSuccs.size())
+            {
+                NodeID succ = nodeSuccs[frames.back().next++];
+                if (!dfsNum.count(succ))
+                    visit(succ);
+                else if (onStack.count(succ))
+                    lowLink[node] = std::min(lowLink[node], dfsNum[succ]);
+                continue;
+            }
+
+            if (lowLink[node] == dfsNum[node])
+            {
+                std::vector<NodeID> cycle;
+                NodeID member;
+                do
+                {
+                    member = sccStack.back();
+                    sccStack.pop_back();
+                    onStack.erase(member);
+                    cycle.push_back(member);
+                }
+                while (member != node);
+                if (cycle.size() > 1)
+                    cycles.push_back(std::move(cycle));
+            }
+            frames.pop_back();
+            if (!frames.empty())
+            {
+                NodeID parent = frames.back().node;
+                lowLink[parent] = std::min(lowLink[parent], lowLink[node]);
+            }
+        }
+    }
+
+    timeOfSCCDetection += (stat->getClk() - sccStart) / TIMEINTERVAL;
+
+    double mergeStart = stat->getClk();
+    for (const std::vector<NodeID>& cycle : cycles)
+    {
+        NodeBS nodes;
+        NodeBS refs;
+        for (NodeID member : cycle)
+        {
+            if (member >= refBase)
+                refs.set(member - refBase);
+            else
+                nodes.set(member);
+        }
+        /// a cycle needs a non-ref node, as there are no edges between ref nodes
+        NodeID target = nodes.find_first();
+        if (refs.empty())
+        {
+            for (NodeID member : nodes)
+            {
+                if (sccRepNode(member) != sccRepNode(target))
+                    mergeNodeToRep(sccRepNode(member), sccRepNode(target));
+            }
+        }
+        else
+        {
+            /// ref may have been merged by a copy-only cycle above; only reps are processed
+            for (NodeID ref : refs)
+                hcdTargets[sccRepNode(ref)].set(target);
+        }
+    }
+    timeOfSCCMerges += (stat->getClk() - mergeStart) / TIMEINTERVAL;
+}
+
+/*!
+ * Every object o pointed to by nodeId is in a cycle with the targets of nodeId
+ * once the copy edges of loads from and stores to o are added, so o is merged
+ * into them now.
+ */
+void AndersenHCD::mergeRefCycles(NodeID nodeId)
+{
+    NodeToTargetsMap::const_iterator it = hcdTargets.find(nodeId);
+    if (it == hcdTargets.end())
+        return;
+
+    double mergeStart = stat->getClk();
+    /// merges change both the targets and the points-to set of nodeId
+    const NodeBS targets = it->second;
+    const PointsTo pts = getPts(nodeId);
+    for (NodeID target : targets)
+    {
+        for (NodeID o : pts)
+        {
+            /// no copy edges are added for constant objects, see processLoad()
+            if (pag->isConstantObj(o))
+                continue;
+            NodeID targetRep = sccRepNode(target);
+            if (sccRepNode(o) != targetRep)
+                mergeNodeToRep(sccRepNode(o), targetRep);
+        }
+        pushIntoWorklist(target);
+    }
+    timeOfSCCMerges += (stat->getClk() - mergeStart) / TIMEINTERVAL;
+}
+
+/*!
+ * Collapse the online part of the offline cycles before resolving nodeId
+ */
+void AndersenHCD::processNode(NodeID nodeId)
+{
+    if (sccRepNode(nodeId) != nodeId)
+        return;
+
+    mergeRefCycles(nodeId);
+    Andersen::processNode(sccRepNode(nodeId));
+}
+
+/*!
+ * The rep dereferences whatever the merged node dereferences
+ */
+bool AndersenHCD::mergeSrcToTgt(NodeID nodeId, NodeID newRepId)
+{
+    if (nodeId == newRepId)
+        return false;
+
+    NodeToTargetsMap::iterator it = hcdTargets.find(nodeId);
+    if (it != hcdTargets.end())
+    {
+        NodeBS targets = it->second;
+        hcdTargets.erase(it);
+        hcdTargets[newRepId] |= targets;
+    }
+    return Andersen::mergeSrcToTgt(nodeId, newRepId);
+}
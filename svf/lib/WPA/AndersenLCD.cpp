@@ -0,0 +1,111 @@
+//===- AndersenLCD.cpp -- Lazy cycle detection based Andersen's analysis-----//
+//
+//                     SVF: Static Value-Flow Analysis
+//
+// Copyright (C) <2013-2017>  <Yulei Sui>
+//
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//===----------------------------------------------------------------------===//
+
+/*
+ * AndersenLCD.cpp
+ */
+
+#include "WPA/AndersenHCD.h"
+
+using namespace SVF;
+using namespace SVFUtil;
+using namespace std;
+
+/*!
+ * Initialize analysis
+ */
+void AndersenLCD::initialize()
+{
+    AndersenHCD::initialize();
+    checkedEdges.clear();
+    lcdCandidates.clear();
+}
+
+/*!
+ * Solve the worklist, detecting cycles from the candidates collected while
+ * processing the previous node
+ */
+void AndersenLCD::solveWorklist()
+{
+    while (!isWorklistEmpty())
+    {
+        NodeID nodeId = popFromWorklist();
+        collapsePWCNode(nodeId);
+        processNode(nodeId);
+        collapseFields();
+
+        if (!lcdCandidates.empty())
+            SCCDetect();
+    }
+}
+
+/*!
+ * SCC detection from the LCD candidates only. The merged reps are pushed
+ * into the worklist to propagate the points-to sets of their subs.
+ */
+NodeStack& AndersenLCD::SCCDetect()
+{
+    numOfSCCDetection++;
+
+    /// candidates may have been merged since they were collected
+    NodeSet candidates;
+    for (NodeID candidate : lcdCandidates)
+        candidates.insert(sccRepNode(candidate));
+    lcdCandidates.clear();
+
+    double sccStart = stat->getClk();
+    WPAConstraintSolver::SCCDetect(candidates);
+    double sccEnd = stat->getClk();
+    timeOfSCCDetection += (sccEnd - sccStart) / TIMEINTERVAL;
+
+    double mergeStart = stat->getClk();
+    mergeSccCycle();
+    double mergeEnd = stat->getClk();
+    timeOfSCCMerges += (mergeEnd - mergeStart) / TIMEINTERVAL;
+
+    NodeStack& topoOrder = getSCCDetector()->topoNodeStack();
+    NodeStack reps = topoOrder;
+    while (!reps.empty())
+    {
+        NodeID rep = reps.top();
+        reps.pop();
+        if (getSCCDetector()->subNodes(rep).count() > 1)
+            pushIntoWorklist(rep);
+    }
+    return topoOrder;
+}
+
+/*!
+ * A copy edge that propagates nothing between equal points-to sets marks its
+ * dst as a cycle detection candidate, once per edge
+ */
+bool AndersenLCD::processCopy(NodeID node, const ConstraintEdge* edge)
+{
+    bool changed = AndersenHCD::processCopy(node, edge);
+
+    NodeID dst = sccRepNode(edge->getDstID());
+    if (!changed && dst != node && getPts(node) == getPts(dst)
+            && checkedEdges.insert(std::make_pair(node, dst)).second)
+        lcdCandidates.insert(dst);
+
+    return changed;
+}
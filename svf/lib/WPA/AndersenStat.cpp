@@ -325,6 +325,7 @@ void AndersenStat::performStat()
 
     PTNumStatMap["NumOfSFRs"] = Andersen::numOfSfrs;
     PTNumStatMap["NumOfFieldExpand"] = Andersen::numOfFieldExpand;
+    PTNumStatMap["NumOfHeapClones"] = Andersen::numOfHeapClones;
 
     PTNumStatMap["Pointers"] = pag->getValueNodeNum();
     PTNumStatMap["MemObjects"] = pag->getObjectNodeNum();
@@ -43,6 +43,16 @@ void AndersenWaveDiff::initialize()
 {
     Andersen::initialize();
     setDetectPWC(true);   // Standard wave propagation always collapses PWCs
+    loadStoreDonePts.clear();
+}
+
+/*!
+ * Finalize
+ */
+void AndersenWaveDiff::finalize()
+{
+    loadStoreDonePts.clear();
+    Andersen::finalize();
 }
 
 /*!
@@ -66,9 +76,10 @@ void AndersenWaveDiff::solveWorklist()
     }
 
     // New nodes will be inserted into workList during processing.
+    // A node pushed before being merged is handled through its rep.
     while (!isWorklistEmpty())
     {
-        NodeID nodeId = popFromWorklist();
+        NodeID nodeId = sccRepNode(popFromWorklist());
         // process nodes in worklist
         postProcessNode(nodeId);
     }
@@ -92,27 +103,57 @@ void AndersenWaveDiff::processNode(NodeID nodeId)
 }
 
 /*!
- * Post process node
+ * Post process node: resolve loads and stores for the objects added to the
+ * node's points-to set since it was last post-processed. Load and store edges
+ * never change between waves (merges are handled in mergeSrcToTgt), so copy
+ * edges for older objects already exist. Nodes without loads and stores are
+ * skipped and record nothing.
  */
 void AndersenWaveDiff::postProcessNode(NodeID nodeId)
 {
-    double insertStart = stat->getClk();
-
     ConstraintNode* node = consCG->getConstraintNode(nodeId);
+    if (adjacency ? adjacency->getLoadOutEdges(nodeId).empty() && adjacency->getStoreInEdges(nodeId).empty()
+            : node->getLoadOutEdges().empty() && node->getStoreInEdges().empty())
+        return;
+
+    double insertStart = stat->getClk();
 
-    // handle load
-    for (ConstraintNode::const_iterator it = node->outgoingLoadsBegin(), eit = node->outgoingLoadsEnd();
-            it != eit; ++it)
+    PointsTo& donePts = loadStoreDonePts[nodeId];
+    PointsTo newPts = getPts(nodeId);
+    newPts.intersectWithComplement(donePts);
+    if (!newPts.empty() && adjacency)
     {
-        if (handleLoad(nodeId, *it))
-            reanalyze = true;
+        donePts |= newPts;
+
+        for (const ConstraintEdge* load : adjacency->getLoadOutEdges(nodeId))
+        {
+            if (handleLoad(newPts, load))
+                reanalyze = true;
+        }
+        for (const ConstraintEdge* store : adjacency->getStoreInEdges(nodeId))
+        {
+            if (handleStore(newPts, store))
+                reanalyze = true;
+        }
     }
-    // handle store
-    for (ConstraintNode::const_iterator it = node->incomingStoresBegin(), eit =  node->incomingStoresEnd();
-            it != eit; ++it)
+    else if (!newPts.empty())
     {
-        if (handleStore(nodeId, *it))
-            reanalyze = true;
+        donePts |= newPts;
+
+        // handle load
+        for (ConstraintNode::const_iterator it = node->outgoingLoadsBegin(), eit = node->outgoingLoadsEnd();
+                it != eit; ++it)
+        {
+            if (handleLoad(newPts, *it))
+                reanalyze = true;
+        }
+        // handle store
+        for (ConstraintNode::const_iterator it = node->incomingStoresBegin(), eit =  node->incomingStoresEnd();
+                it != eit; ++it)
+        {
+            if (handleStore(newPts, *it))
+                reanalyze = true;
+        }
     }
 
     double insertEnd = stat->getClk();
@@ -122,13 +163,12 @@ void AndersenWaveDiff::postProcessNode(NodeID nodeId)
 /*!
  * Handle load
  */
-bool AndersenWaveDiff::handleLoad(NodeID nodeId, const ConstraintEdge* edge)
+bool AndersenWaveDiff::handleLoad(const PointsTo& pts, const ConstraintEdge* edge)
 {
     bool changed = false;
-    for (PointsTo::iterator piter = getPts(nodeId).begin(), epiter = getPts(nodeId).end();
-            piter != epiter; ++piter)
+    for (NodeID ptd : pts)
     {
-        if (processLoad(*piter, edge))
+        if (processLoad(ptd, edge))
         {
             changed = true;
         }
@@ -136,19 +176,50 @@ bool AndersenWaveDiff::handleLoad(NodeID nodeId, const ConstraintEdge* edge)
     return changed;
 }
 
+/*!
+ * Handle load for all the objects pointed to by nodeId
+ */
+bool AndersenWaveDiff::handleLoad(NodeID nodeId, const ConstraintEdge* edge)
+{
+    return handleLoad(getPts(nodeId), edge);
+}
+
 /*!
  * Handle store
  */
-bool AndersenWaveDiff::handleStore(NodeID nodeId, const ConstraintEdge* edge)
+bool AndersenWaveDiff::handleStore(const PointsTo& pts, const ConstraintEdge* edge)
 {
     bool changed = false;
-    for (PointsTo::iterator piter = getPts(nodeId).begin(), epiter = getPts(nodeId).end();
-            piter != epiter; ++piter)
+    for (NodeID ptd : pts)
     {
-        if (processStore(*piter, edge))
+        if (processStore(ptd, edge))
         {
             changed = true;
         }
     }
     return changed;
 }
+
+/*!
+ * Handle store for all the objects pointed to by nodeId
+ */
+bool AndersenWaveDiff::handleStore(NodeID nodeId, const ConstraintEdge* edge)
+{
+    return handleStore(getPts(nodeId), edge);
+}
+
+/*!
+ * The rep inherits the load and store edges of the merged node, which have not
+ * been resolved for the rep's objects: forget what the rep has resolved and
+ * post-process it again in this wave.
+ */
+bool AndersenWaveDiff::mergeSrcToTgt(NodeID srcId, NodeID tgtId)
+{
+    if (srcId == tgtId)
+        return false;
+    bool pwc = Andersen::mergeSrcToTgt(srcId, tgtId);
+    loadStoreDonePts.erase(srcId);
+    loadStoreDonePts.erase(tgtId);
+    pushIntoWorklist(tgtId);
+    return pwc;
+}
@@ -29,6 +29,10 @@
  */
 
 #include "WPA/Steensgaard.h"
+#include "Util/Options.h"
+#include <array>
+#include <numeric>
+#include <thread>
 
 using namespace SVF;
 using namespace SVFUtil;
@@ -42,61 +46,162 @@ Steensgaard* Steensgaard::steens = nullptr;
 void Steensgaard::solveWorklist()
 {
 
+    ingestConstraints();
     processAllAddr();
 
     // Keep solving until workList is empty.
     while (!isWorklistEmpty())
     {
         NodeID nodeId = popFromWorklist();
-        ConstraintNode* node = consCG->getConstraintNode(nodeId);
 
-        /// foreach o \in pts(p)
-        for (NodeID o : getPts(nodeId))
+        /// foreach o \in pts(p); a copy since unions below may move or clear the class's set
+        PointsTo pts = getPts(nodeId);
+        for (NodeID o : pts)
         {
 
             /// *p = q : EC(o) == EC(q)
-            for (ConstraintEdge* edge : node->getStoreInEdges())
+            for (u32_t i = storeSrcs.rowBegin(nodeId), e = storeSrcs.rowEnd(nodeId); i < e; ++i)
             {
-                ecUnion(edge->getSrcID(), o);
+                ecUnion(storeSrcs.targets[i], o);
             }
             // r = *p : EC(r) == EC(o)
-            for (ConstraintEdge* edge : node->getLoadOutEdges())
+            for (u32_t i = loadDsts.rowBegin(nodeId), e = loadDsts.rowEnd(nodeId); i < e; ++i)
             {
-                ecUnion(o, edge->getDstID());
+                ecUnion(o, loadDsts.targets[i]);
             }
         }
 
         /// q = p : EC(q) == EC(p)
-        for (ConstraintEdge* edge : node->getCopyOutEdges())
+        /// q = &p->f : EC(q) == EC(p)
+        for (u32_t i = directDsts.rowBegin(nodeId), e = directDsts.rowEnd(nodeId); i < e; ++i)
         {
-            ecUnion(edge->getSrcID(), edge->getDstID());
+            ecUnion(nodeId, directDsts.targets[i]);
         }
-        /// q = &p->f : EC(q) == EC(p)
-        for (ConstraintEdge* edge : node->getGepOutEdges())
+    }
+}
+
+/*!
+ * Copy the edges the solver follows out of the constraint graph's per-node edge
+ * sets into flat arrays. Ranges of node IDs are read by Options::SteensThreads()
+ * workers into their own rows, which are then concatenated in ID order.
+ */
+void Steensgaard::ingestConstraints()
+{
+    NodeID numNodes = 0;
+    for (ConstraintGraph::const_iterator it = consCG->begin(), eit = consCG->end(); it != eit; ++it)
+        numNodes = std::max(numNodes, it->first + 1);
+
+    // singleton classes for nodes seen for the first time
+    NodeID oldSize = ecParent.size();
+    if (numNodes > oldSize)
+    {
+        ecParent.resize(numNodes);
+        std::iota(ecParent.begin() + oldSize, ecParent.end(), oldSize);
+        ecRank.resize(numNodes, 0);
+    }
+
+    u32_t numChunks = std::min<u32_t>(std::max<u32_t>(Options::SteensThreads(), 1), std::max<NodeID>(numNodes, 1));
+    u32_t chunkSize = (numNodes + numChunks - 1) / numChunks;
+    std::vector<std::array<EdgeRows, 3>> chunks(numChunks);
+    auto ingestChunk = [&](u32_t c)
+    {
+        NodeID lo = std::min<NodeID>(c * chunkSize, numNodes);
+        NodeID hi = std::min<NodeID>(lo + chunkSize, numNodes);
+        EdgeRows& stores = chunks[c][0];
+        EdgeRows& loads = chunks[c][1];
+        EdgeRows& directs = chunks[c][2];
+        for (EdgeRows& rows : chunks[c])
+            rows.offsets.push_back(0);
+        for (NodeID n = lo; n < hi; ++n)
+        {
+            if (consCG->hasConstraintNode(n))
+            {
+                const ConstraintNode* node = consCG->getConstraintNode(n);
+                for (const ConstraintEdge* edge : node->getStoreInEdges())
+                    stores.targets.push_back(edge->getSrcID());
+                for (const ConstraintEdge* edge : node->getLoadOutEdges())
+                    loads.targets.push_back(edge->getDstID());
+                for (const ConstraintEdge* edge : node->getCopyOutEdges())
+                    directs.targets.push_back(edge->getDstID());
+                for (const ConstraintEdge* edge : node->getGepOutEdges())
+                    directs.targets.push_back(edge->getDstID());
+            }
+            for (EdgeRows& rows : chunks[c])
+                rows.offsets.push_back(rows.targets.size());
+        }
+    };
+
+    if (numChunks <= 1)
+        ingestChunk(0);
+    else
+    {
+        std::vector<std::thread> workers;
+        for (u32_t c = 0; c < numChunks; ++c)
+            workers.push_back(std::thread(ingestChunk, c));
+        for (std::thread &w : workers)
+            w.join();
+    }
+
+    EdgeRows* merged[3] = {&storeSrcs, &loadDsts, &directDsts};
+    for (u32_t k = 0; k < 3; ++k)
+    {
+        EdgeRows& rows = *merged[k];
+        rows.offsets.assign(1, 0);
+        rows.targets.clear();
+        for (const std::array<EdgeRows, 3>& chunk : chunks)
         {
-            ecUnion(edge->getSrcID(), edge->getDstID());
+            const EdgeRows& local = chunk[k];
+            u32_t base = rows.targets.size();
+            for (u32_t i = 1; i < local.offsets.size(); ++i)
+                rows.offsets.push_back(base + local.offsets[i]);
+            rows.targets.insert(rows.targets.end(), local.targets.begin(), local.targets.end());
         }
     }
 }
 
-void Steensgaard::setEC(NodeID node, NodeID rep)
+NodeID Steensgaard::setEC(NodeID node, NodeID rep)
 {
+    node = getEC(node);
     rep = getEC(rep);
-    Set<NodeID>& subNodes = getSubNodes(node);
-    for (NodeID sub : subNodes)
+    if (node == rep)
+        return rep;
+
+    NodeID maxId = std::max(node, rep);
+    if (maxId >= ecParent.size())
     {
-        nodeToECMap[sub] = rep;
-        addSubNode(rep, sub);
+        NodeID oldSize = ecParent.size();
+        ecParent.resize(maxId + 1);
+        std::iota(ecParent.begin() + oldSize, ecParent.end(), oldSize);
+        ecRank.resize(maxId + 1, 0);
     }
-    subNodes.clear();
+
+    // union by rank: hang the shallower tree below the deeper one
+    if (ecRank[node] > ecRank[rep])
+        std::swap(node, rep);
+    ecParent[node] = rep;
+    if (ecRank[node] == ecRank[rep])
+        ecRank[rep]++;
+    return rep;
 }
 
 /// merge node into equiv class and merge node's pts into ec's pts
 void Steensgaard::ecUnion(NodeID node, NodeID ec)
 {
-    if (unionPts(ec, node))
+    NodeID nodeRep = getEC(node);
+    NodeID ecRep = getEC(ec);
+    if (nodeRep == ecRep)
+        return;
+
+    bool changed = getPTDataTy()->unionPts(ecRep, nodeRep);
+    NodeID rep = setEC(nodeRep, ecRep);
+    // keep the class's points-to set only at its new representative
+    NodeID merged = rep == ecRep ? nodeRep : ecRep;
+    if (rep != ecRep)
+        getPTDataTy()->unionPts(rep, ecRep);
+    getPTDataTy()->clearFullPts(merged);
+
+    if (changed)
         pushIntoWorklist(ec);
-    setEC(node, ec);
 }
 
 /*!
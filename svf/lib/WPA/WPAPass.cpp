@@ -38,6 +38,7 @@
 #include "WPA/WPAPass.h"
 #include "WPA/Andersen.h"
 #include "WPA/AndersenPWC.h"
+#include "WPA/AndersenHCD.h"
 #include "WPA/FlowSensitive.h"
 #include "WPA/VersionedFlowSensitive.h"
 #include "WPA/TypeAnalysis.h"
@@ -93,6 +94,12 @@ void WPAPass::runPointerAnalysis(SVFIR* pag, u32_t kind)
     case PointerAnalysis::AndersenSFR_WPA:
         _pta = new AndersenSFR(pag);
         break;
+    case PointerAnalysis::AndersenHCD_WPA:
+        _pta = new AndersenHCD(pag);
+        break;
+    case PointerAnalysis::AndersenLCD_WPA:
+        _pta = new AndersenLCD(pag);
+        break;
     case PointerAnalysis::AndersenWaveDiff_WPA:
         _pta = new AndersenWaveDiff(pag);
         break;
@@ -113,6 +120,11 @@ void WPAPass::runPointerAnalysis(SVFIR* pag, u32_t kind)
         return;
     }
 
+    /// the points-to sets of plain Andersen's are read directly, unless an SVFG is built from them
+    if ((kind == PointerAnalysis::Andersen_WPA || kind == PointerAnalysis::AndersenWaveDiff_WPA)
+            && !Options::AnderSVFG())
+        SVFUtil::cast<AndersenBase>(_pta)->setHeapCloning(true);
+
     ptaVector.push_back(_pta);
     _pta->analyze();
     if (Options::AnderSVFG())